@@ -0,0 +1,367 @@
+/**
+ * @file bench.cpp
+ * @brief Benchmark suite timing every bigint operation across operand sizes.
+ *
+ * Usage: bigint_bench [--max-digits N] [--min-time SECONDS] [--output FILE]
+ *
+ * Each operation is timed on random operands of 1, 3, 10, 30, ... digits up
+ * to --max-digits (default 10^7). The JSON report lists ns/op, heap
+ * allocations/op and bytes/op for every size, plus a complexity exponent
+ * fitted over the sizes from 1000 digits up, so runs from different releases
+ * can be diffed to catch regressions.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <new>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "bigint.hpp"
+
+/// Heap allocations and bytes requested since start-up, counted by the replaced operator new.
+static std::atomic<size_t> allocationCount{0};
+static std::atomic<size_t> allocationBytes{0};
+
+/**
+ * @brief Counts and performs one allocation for the replaced global operator new.
+ */
+static void *countedAllocate(size_t size, size_t alignment) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocationBytes.fetch_add(size, std::memory_order_relaxed);
+    size = size == 0 ? 1 : size;
+    void *p = alignment <= alignof(std::max_align_t)
+                  ? std::malloc(size)
+                  : std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+/**
+ * @brief Releases memory from countedAllocate; kept out of line so callers never see the malloc/free pair.
+ */
+__attribute__((noinline)) static void countedRelease(void *p) noexcept {
+    std::free(p);
+}
+
+void *operator new(size_t size) {
+    return countedAllocate(size, alignof(std::max_align_t));
+}
+void *operator new[](size_t size) {
+    return countedAllocate(size, alignof(std::max_align_t));
+}
+void *operator new(size_t size, std::align_val_t alignment) {
+    return countedAllocate(size, static_cast<size_t>(alignment));
+}
+void *operator new[](size_t size, std::align_val_t alignment) {
+    return countedAllocate(size, static_cast<size_t>(alignment));
+}
+void operator delete(void *p) noexcept {
+    countedRelease(p);
+}
+void operator delete[](void *p) noexcept {
+    countedRelease(p);
+}
+void operator delete(void *p, size_t) noexcept {
+    countedRelease(p);
+}
+void operator delete[](void *p, size_t) noexcept {
+    countedRelease(p);
+}
+void operator delete(void *p, std::align_val_t) noexcept {
+    countedRelease(p);
+}
+void operator delete[](void *p, std::align_val_t) noexcept {
+    countedRelease(p);
+}
+void operator delete(void *p, size_t, std::align_val_t) noexcept {
+    countedRelease(p);
+}
+void operator delete[](void *p, size_t, std::align_val_t) noexcept {
+    countedRelease(p);
+}
+
+/**
+ * @brief Keeps the compiler from discarding a value that is never read.
+ */
+template <class T>
+void doNotOptimize(const T &value) {
+    asm volatile("" : : "r"(&value) : "memory");
+}
+
+/**
+ * @brief One measurement: an operation at one operand size.
+ */
+struct sample {
+    std::string op;
+    size_t digits;
+    double nsPerOp;
+    double allocsPerOp;
+    double bytesPerOp;
+    size_t iterations;
+};
+
+/**
+ * @brief Builds a random positive decimal string with the given number of digits.
+ */
+std::string randomDigits(size_t digits, std::mt19937_64 &rng) {
+    std::string number(1, static_cast<char>('1' + rng() % 9));
+    for (size_t i = 1; i < digits; ++i) {
+        number += static_cast<char>('0' + rng() % 10);
+    }
+    return number;
+}
+
+/**
+ * @brief Runs body repeatedly for at least minTime seconds (and at least once).
+ *
+ * Iterations are batched, doubling the batch size, so the clock is read
+ * rarely for fast operations.
+ */
+sample measure(const std::string &op, size_t digits, double minTime, const std::function<void()> &body) {
+    size_t iterations = 0;
+    size_t batch = 1;
+    size_t allocsBefore = allocationCount.load(std::memory_order_relaxed);
+    size_t bytesBefore = allocationBytes.load(std::memory_order_relaxed);
+    auto start = std::chrono::steady_clock::now();
+    double elapsed = 0;
+    for (;;) {
+        for (size_t i = 0; i < batch; ++i) {
+            body();
+        }
+        iterations += batch;
+        elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (elapsed >= minTime) {
+            break;
+        }
+        batch *= 2;
+    }
+    double n = static_cast<double>(iterations);
+    return {op, digits, elapsed * 1e9 / n,
+            static_cast<double>(allocationCount.load(std::memory_order_relaxed) - allocsBefore) / n,
+            static_cast<double>(allocationBytes.load(std::memory_order_relaxed) - bytesBefore) / n, iterations};
+}
+
+/**
+ * @brief Least-squares slope of log(ns/op) against log(digits) over sizes of at least 1000 digits.
+ * @return The fitted exponent k in time ~ digits^k, or NaN with fewer than two such sizes.
+ */
+double fitExponent(const std::vector<sample> &samples, const std::string &op) {
+    double sx = 0, sy = 0, sxx = 0, sxy = 0;
+    int count = 0;
+    for (const sample &s : samples) {
+        if (s.op != op || s.digits < 1000) {
+            continue;
+        }
+        double x = std::log(static_cast<double>(s.digits));
+        double y = std::log(s.nsPerOp);
+        sx += x;
+        sy += y;
+        sxx += x * x;
+        sxy += x * y;
+        ++count;
+    }
+    if (count < 2) {
+        return std::nan("");
+    }
+    return (count * sxy - sx * sy) / (count * sxx - sx * sx);
+}
+
+/**
+ * @brief Names the textbook complexity class closest to a fitted exponent.
+ */
+std::string nearestModel(double exponent) {
+    static const std::pair<double, const char *> models[] = {
+        {0.0, "O(1)"}, {1.0, "O(n)"}, {1.15, "O(n log n)"}, {1.465, "O(n^1.465)"}, {1.585, "O(n^1.585)"}, {2.0, "O(n^2)"}};
+    const char *best = models[0].second;
+    double bestDistance = INFINITY;
+    for (const auto &model : models) {
+        double distance = std::fabs(exponent - model.first);
+        if (distance < bestDistance) {
+            bestDistance = distance;
+            best = model.second;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Formats a double for JSON, writing null for values JSON cannot represent.
+ */
+std::string jsonNumber(double value) {
+    if (!std::isfinite(value)) {
+        return "null";
+    }
+    std::ostringstream out;
+    out.precision(6);
+    out << value;
+    return out.str();
+}
+
+int main(int argc, char **argv) {
+    size_t maxDigits = 10000000;
+    double minTime = 0.2;
+    std::string outputPath;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--max-digits" && i + 1 < argc) {
+            maxDigits = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--min-time" && i + 1 < argc) {
+            minTime = std::strtod(argv[++i], nullptr);
+        } else if (arg == "--output" && i + 1 < argc) {
+            outputPath = argv[++i];
+        } else {
+            std::cerr << "usage: " << argv[0] << " [--max-digits N] [--min-time SECONDS] [--output FILE]\n";
+            return 2;
+        }
+    }
+
+    std::vector<size_t> sizes;
+    for (size_t digits = 1; digits <= maxDigits; digits *= 10) {
+        sizes.push_back(digits);
+        if (3 * digits <= maxDigits) {
+            sizes.push_back(3 * digits);
+        }
+    }
+
+    std::mt19937_64 rng(701);
+    std::vector<sample> samples;
+    std::vector<std::string> ops;
+    auto record = [&](const sample &s) {
+        if (std::find(ops.begin(), ops.end(), s.op) == ops.end()) {
+            ops.push_back(s.op);
+        }
+        samples.push_back(s);
+        std::cerr << s.op << " " << s.digits << " digits: " << s.nsPerOp << " ns/op\n";
+    };
+
+    for (size_t digits : sizes) {
+        std::string aText = randomDigits(digits, rng);
+        std::string bText = randomDigits(digits, rng);
+        std::string wideText = randomDigits(2 * digits, rng);
+        const bigint a(aText);
+        const bigint b(bText);
+        const bigint wide(wideText);
+        const bigint same = a;
+
+        if (digits <= 18) {
+            int64_t small = static_cast<int64_t>(std::stoll(aText));
+            record(measure("construct_int64", digits, minTime, [&] {
+                bigint r(small);
+                doNotOptimize(r);
+            }));
+        }
+        record(measure("copy", digits, minTime, [&] {
+            bigint r(a);
+            doNotOptimize(r);
+        }));
+        record(measure("parse", digits, minTime, [&] {
+            bigint r(aText);
+            doNotOptimize(r);
+        }));
+        record(measure("print", digits, minTime, [&] {
+            std::ostringstream out;
+            out << a;
+            doNotOptimize(out);
+        }));
+        record(measure("add", digits, minTime, [&] {
+            bigint r = a + b;
+            doNotOptimize(r);
+        }));
+        record(measure("sub", digits, minTime, [&] {
+            bigint r = a - b;
+            doNotOptimize(r);
+        }));
+        record(measure("mul", digits, minTime, [&] {
+            bigint r = a * b;
+            doNotOptimize(r);
+        }));
+        record(measure("div", digits, minTime, [&] {
+            bigint r = wide / b;
+            doNotOptimize(r);
+        }));
+        record(measure("mod", digits, minTime, [&] {
+            bigint r = wide % b;
+            doNotOptimize(r);
+        }));
+        record(measure("compare", digits, minTime, [&] {
+            bool r = a < same;
+            doNotOptimize(r);
+        }));
+        uint64_t exponent = static_cast<uint64_t>(static_cast<double>(digits) / std::log10(3.0)) + 1;
+        record(measure("pow", digits, minTime, [&] {
+            bigint r = pow(bigint(3), exponent);
+            doNotOptimize(r);
+        }));
+        record(measure("isqrt", digits, minTime, [&] {
+            bigint r = isqrt(wide);
+            doNotOptimize(r);
+        }));
+        record(measure("iroot3", digits, minTime, [&] {
+            bigint r = iroot(wide, 3);
+            doNotOptimize(r);
+        }));
+        record(measure("square", digits, minTime, [&] {
+            bigint r = square(a);
+            doNotOptimize(r);
+        }));
+        record(measure("gcd", digits, minTime, [&] {
+            bigint r = gcd(a, b);
+            doNotOptimize(r);
+        }));
+        bigint acc = a;
+        record(measure("add_assign", digits, minTime, [&] {
+            acc += b;
+            doNotOptimize(acc);
+        }));
+        record(measure("sub_assign", digits, minTime, [&] {
+            acc -= b;
+            doNotOptimize(acc);
+        }));
+        record(measure("mul_assign", digits, minTime, [&] {
+            acc = a;
+            acc *= b;
+            doNotOptimize(acc);
+        }));
+    }
+
+    std::ostringstream json;
+    json << "{\n  \"config\": {\"max_digits\": " << maxDigits << ", \"min_time\": " << jsonNumber(minTime)
+         << ", \"simd_level\": " << static_cast<int>(bigint_detail::detectSimd())
+         << ", \"karatsuba_threshold\": " << bigint_tuning::karatsubaThreshold
+         << ", \"toom3_threshold\": " << bigint_tuning::toom3Threshold
+         << ", \"ntt_threshold\": " << bigint_tuning::nttThreshold
+         << ", \"newton_threshold\": " << bigint_tuning::newtonThreshold
+         << ", \"decimal_threshold\": " << bigint_tuning::decimalThreshold << "},\n";
+    json << "  \"results\": [\n";
+    for (size_t i = 0; i < samples.size(); ++i) {
+        const sample &s = samples[i];
+        json << "    {\"op\": \"" << s.op << "\", \"digits\": " << s.digits << ", \"ns_per_op\": " << jsonNumber(s.nsPerOp)
+             << ", \"allocs_per_op\": " << jsonNumber(s.allocsPerOp) << ", \"bytes_per_op\": " << jsonNumber(s.bytesPerOp)
+             << ", \"iterations\": " << s.iterations << "}" << (i + 1 < samples.size() ? "," : "") << "\n";
+    }
+    json << "  ],\n  \"complexity\": [\n";
+    for (size_t i = 0; i < ops.size(); ++i) {
+        double exponent = fitExponent(samples, ops[i]);
+        json << "    {\"op\": \"" << ops[i] << "\", \"exponent\": " << jsonNumber(exponent) << ", \"model\": "
+             << (std::isfinite(exponent) ? "\"" + nearestModel(exponent) + "\"" : std::string("null")) << "}"
+             << (i + 1 < ops.size() ? "," : "") << "\n";
+    }
+    json << "  ]\n}\n";
+
+    if (outputPath.empty()) {
+        std::cout << json.str();
+    } else {
+        std::ofstream(outputPath) << json.str();
+    }
+    return 0;
+}
@@ -0,0 +1,72 @@
+/**
+ * @file bench_parallel.cpp
+ * @brief Measures how multiplication of huge operands scales with bigint_tuning::threads.
+ *
+ * Usage: ./bench_parallel [digits] [max_threads]
+ * Prints one line per thread count with the time per product and the speedup
+ * over the serial run, and checks every parallel product against the serial one.
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include "bigint.hpp"
+
+/**
+ * @brief Builds a random positive number with the given number of decimal digits.
+ */
+bigint randomBigint(size_t digits, std::mt19937_64 &rng) {
+    std::string number(1, static_cast<char>('1' + rng() % 9));
+    for (size_t i = 1; i < digits; ++i) {
+        number += static_cast<char>('0' + rng() % 10);
+    }
+    return bigint(number);
+}
+
+/**
+ * @brief Returns the average seconds per call of f over at least half a second.
+ */
+template <class F>
+double timePerCall(F f) {
+    auto start = std::chrono::steady_clock::now();
+    int calls = 0;
+    double elapsed = 0;
+    do {
+        f();
+        ++calls;
+        elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    } while (elapsed < 0.5);
+    return elapsed / calls;
+}
+
+int main(int argc, char **argv) {
+    size_t digits = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000000;
+    size_t maxThreads = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : std::thread::hardware_concurrency();
+    maxThreads = std::max<size_t>(maxThreads, 1);
+
+    std::mt19937_64 rng(701);
+    bigint a = randomBigint(digits, rng);
+    bigint b = randomBigint(digits, rng);
+
+    bigint_tuning::threads = 1;
+    bigint serial = a * b;
+    double serialTime = timePerCall([&] { serial = a * b; });
+    std::cout << "digits " << digits << '\n';
+    std::cout << "threads 1: " << serialTime * 1e3 << " ms, speedup 1.00\n";
+
+    bool identical = true;
+    for (size_t threads = 2; threads <= maxThreads; threads *= 2) {
+        bigint_tuning::threads = threads;
+        bigint product;
+        double time = timePerCall([&] { product = a * b; });
+        identical = identical && product == serial;
+        std::cout << "threads " << threads << ": " << time * 1e3 << " ms, speedup "
+                  << serialTime / time << '\n';
+    }
+    bigint_tuning::threads = 1;
+    std::cout << (identical ? "parallel products match the serial product\n" : "MISMATCH\n");
+    return identical ? 0 : 1;
+}
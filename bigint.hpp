@@ -3,431 +3,6267 @@
  * @brief A header file defining the `bigint` class.
  */
 
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <istream>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define BIGINT_X86_KERNELS 1
+#else
+#define BIGINT_X86_KERNELS 0
+#endif
+
+/// Define as 1 before including this header to collect bigint_stats; when 0 every hook compiles away.
+#ifndef BIGINT_INSTRUMENTATION
+#define BIGINT_INSTRUMENTATION 0
+#endif
+
+#if BIGINT_INSTRUMENTATION
+#include <chrono>
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define BIGINT_HAS_MMAP 1
+#else
+#define BIGINT_HAS_MMAP 0
+#endif
+
+/**
+ * @brief Size thresholds (in limbs) used to pick between multiplication algorithms.
+ *
+ * The defaults are the measured crossovers of an -O2 build on x86-64; adjust
+ * them at start-up if a different machine favours other values. Changing them
+ * never affects results, only speed.
+ */
+struct bigint_tuning {
+    /// Smallest operand size that uses Karatsuba instead of schoolbook.
+    static inline size_t karatsubaThreshold = 32;
+    /// Smallest operand size that uses Toom-3 instead of Karatsuba.
+    static inline size_t toom3Threshold = 256;
+    /// Smallest operand size that uses the three-prime NTT instead of Toom-3.
+    static inline size_t nttThreshold = 6144;
+    /// Smallest size whose square uses Karatsuba instead of schoolbook squaring.
+    static inline size_t sqrKaratsubaThreshold = 48;
+    /// Smallest size whose square uses Toom-3 instead of Karatsuba.
+    static inline size_t sqrToom3Threshold = 400;
+    /// Smallest size whose square uses the NTT instead of Toom-3.
+    static inline size_t sqrNttThreshold = 8192;
+    /// Smallest divisor and quotient size that divides by Newton reciprocal instead of Knuth D.
+    static inline size_t newtonThreshold = 4096;
+    /// Smallest size that converts to and from decimal by divide and conquer.
+    static inline size_t decimalThreshold = 32;
+    /// Smallest odd modulus size for which powmod uses Barrett instead of Montgomery reduction.
+    static inline size_t montgomeryThreshold = 320;
+    /// Smallest operand size whose GCD uses Schoenhage's half-GCD instead of Lehmer steps.
+    static inline size_t hgcdThreshold = 100;
+    /// Threads a single multiplication may use; 1 keeps every product on the calling thread.
+    static inline size_t threads = 1;
+    /// Smallest operand size whose subproducts are spread over the pool when threads > 1.
+    static inline size_t parallelThreshold = 2048;
+};
+
+/**
+ * @brief Public operations counted by bigint_stats.
+ *
+ * Mixed operations with int64_t count under the same entry as their bigint
+ * form; divmod() counts as div.
+ */
+enum class bigint_op { add, sub, mul, div, mod, compare, parse, print, reduce, mulmod, powmod, count };
+
+/**
+ * @brief Algorithm tiers whose time bigint_stats measures.
+ *
+ * Time is exclusive per thread: a Toom-3 product is charged only for its own
+ * evaluation and interpolation, its subproducts for the tiers they run in.
+ * Subproducts run on the thread pool are also counted in the spawning tier.
+ */
+enum class bigint_tier {
+    mulBasecase, mulKaratsuba, mulToom3, mulNtt,
+    divBasecase, divNewton, reciprocal,
+    printBasecase, parseBasecase, count
+};
+
+/**
+ * @brief Low-level kernels operating on little-endian arrays of 64-bit limbs.
+ *
+ * All functions work on raw magnitudes (no sign). Output buffers are supplied
+ * by the caller and must be large enough for the documented result size.
+ */
+namespace bigint_detail {
+
+using limb = uint64_t;
+__extension__ typedef unsigned __int128 dlimb;
+__extension__ typedef __int128 sdlimb;
+
+/// Number of decimal digits stored per limb when converting to/from text.
+constexpr size_t DIGITS_PER_LIMB = 19;
+/// 10^DIGITS_PER_LIMB, the largest power of ten that fits in a limb.
+constexpr limb DECIMAL_BASE = 10000000000000000000ULL;
+
+/// First eight bytes of a file written by write_bigints().
+constexpr char FILE_MAGIC[8] = {'B', 'I', 'G', 'I', 'N', 'T', '0', '1'};
+/// Flag bit in a binary record header marking a negative value.
+constexpr limb NEGATIVE_FLAG = limb{1} << 32;
+
+/**
+ * @brief Converts between host order and the little-endian order of the binary format.
+ */
+inline limb littleEndian(limb value) {
+    if constexpr (std::endian::native == std::endian::big) {
+        return std::byteswap(value);
+    }
+    return value;
+}
+
+/**
+ * @brief The per-thread memory resource slot; null means the process default.
+ */
+inline std::pmr::memory_resource *&threadResourceSlot() {
+    static thread_local std::pmr::memory_resource *resource = nullptr;
+    return resource;
+}
+
+/**
+ * @brief The memory resource new bigints and internal temporaries allocate from on this thread.
+ */
+inline std::pmr::memory_resource *currentResource() {
+    std::pmr::memory_resource *resource = threadResourceSlot();
+    return resource != nullptr ? resource : std::pmr::get_default_resource();
+}
+
+/// Number of operand-size buckets; bucket k counts sizes of 2^(k-1) to 2^k - 1 limbs.
+constexpr size_t SIZE_BUCKETS = 33;
+constexpr size_t OP_COUNT = static_cast<size_t>(bigint_op::count);
+constexpr size_t TIER_COUNT = static_cast<size_t>(bigint_tier::count);
+
+#if BIGINT_INSTRUMENTATION
+/**
+ * @brief Process-wide instrumentation counters, updated with relaxed atomics.
+ */
+struct statsCounters {
+    std::atomic<uint64_t> calls[OP_COUNT];
+    std::atomic<uint64_t> sizes[OP_COUNT][SIZE_BUCKETS];
+    std::atomic<uint64_t> tierCalls[TIER_COUNT];
+    std::atomic<uint64_t> tierNanos[TIER_COUNT];
+    std::atomic<uint64_t> allocations;
+    std::atomic<uint64_t> bytesAllocated;
+};
+
+inline statsCounters statsStorage{};
+#endif
+
+/**
+ * @brief Counts one call of op on operands of at most limbs limbs.
+ */
+inline void recordOp([[maybe_unused]] bigint_op op, [[maybe_unused]] size_t limbs) {
+#if BIGINT_INSTRUMENTATION
+    size_t i = static_cast<size_t>(op);
+    size_t bucket = std::min<size_t>(static_cast<size_t>(std::bit_width(limbs)), SIZE_BUCKETS - 1);
+    statsStorage.calls[i].fetch_add(1, std::memory_order_relaxed);
+    statsStorage.sizes[i][bucket].fetch_add(1, std::memory_order_relaxed);
+#endif
+}
+
+/**
+ * @brief Counts one allocation of bytes for limb storage or a scratch buffer.
+ */
+inline void recordAllocation([[maybe_unused]] size_t bytes) {
+#if BIGINT_INSTRUMENTATION
+    statsStorage.allocations.fetch_add(1, std::memory_order_relaxed);
+    statsStorage.bytesAllocated.fetch_add(bytes, std::memory_order_relaxed);
+#endif
+}
+
+/**
+ * @brief Charges the time between construction and destruction to an algorithm tier.
+ *
+ * Timers nest per thread: time spent in an inner timer on the same thread is
+ * subtracted from the enclosing one. Subproducts that forkJoin runs on pool
+ * threads are not subtracted, so with bigint_tuning::threads above 1 their
+ * time is also left in the spawning tier and the tier totals may overlap.
+ */
+class tierTimer {
+public:
+    explicit tierTimer([[maybe_unused]] bigint_tier tier) {
+#if BIGINT_INSTRUMENTATION
+        index = static_cast<size_t>(tier);
+        parent = innermost();
+        innermost() = this;
+        start = std::chrono::steady_clock::now();
+#endif
+    }
+    ~tierTimer() {
+#if BIGINT_INSTRUMENTATION
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+        uint64_t total = static_cast<uint64_t>(elapsed.count());
+        statsStorage.tierCalls[index].fetch_add(1, std::memory_order_relaxed);
+        statsStorage.tierNanos[index].fetch_add(total - std::min(total, childNanos), std::memory_order_relaxed);
+        if (parent != nullptr) {
+            parent->childNanos += total;
+        }
+        innermost() = parent;
+#endif
+    }
+    tierTimer(const tierTimer &) = delete;
+    tierTimer &operator=(const tierTimer &) = delete;
+
+#if BIGINT_INSTRUMENTATION
+private:
+    size_t index;
+    tierTimer *parent;
+    uint64_t childNanos = 0;
+    std::chrono::steady_clock::time_point start;
+
+    static tierTimer *&innermost() {
+        static thread_local tierTimer *timer = nullptr;
+        return timer;
+    }
+#endif
+};
+
+#if BIGINT_INSTRUMENTATION
+/**
+ * @brief A polymorphic allocator that reports every allocation to the instrumentation counters.
+ */
+template <class T>
+class countingAllocator : public std::pmr::polymorphic_allocator<T> {
+public:
+    using std::pmr::polymorphic_allocator<T>::polymorphic_allocator;
+    countingAllocator(const std::pmr::polymorphic_allocator<T> &other) : std::pmr::polymorphic_allocator<T>(other) {}
+    template <class U>
+    struct rebind {
+        using other = countingAllocator<U>;
+    };
+    T *allocate(size_t n) {
+        recordAllocation(n * sizeof(T));
+        return std::pmr::polymorphic_allocator<T>::allocate(n);
+    }
+    countingAllocator select_on_container_copy_construction() const {
+        return countingAllocator();
+    }
+};
+
+template <class T>
+using scratchAllocator = countingAllocator<T>;
+#else
+template <class T>
+using scratchAllocator = std::pmr::polymorphic_allocator<T>;
+#endif
+
+/**
+ * @brief A std::pmr::vector that allocates from the current thread's bigint resource.
+ *
+ * Used for every temporary buffer inside the arithmetic kernels, so that a
+ * computation run under a bigint_arena never touches the global heap.
+ */
+template <class T>
+class scratchVector : public std::vector<T, scratchAllocator<T>> {
+    using base = std::vector<T, scratchAllocator<T>>;
+
+public:
+    scratchVector() : base(currentResource()) {}
+    explicit scratchVector(size_t n, const T &value = T()) : base(n, value, currentResource()) {}
+    scratchVector(const T *first, const T *last) : base(first, last, currentResource()) {}
+    explicit scratchVector(std::pmr::memory_resource *resource) : base(resource) {}
+    scratchVector(const scratchVector &other) : base(other, currentResource()) {}
+    scratchVector(const scratchVector &other, std::pmr::memory_resource *resource) : base(other, resource) {}
+    scratchVector(scratchVector &&other) noexcept = default;
+    scratchVector &operator=(const scratchVector &other) = default;
+    scratchVector &operator=(scratchVector &&other) = default;
+};
+
+using limbBuffer = scratchVector<limb>;
+
+/**
+ * @brief A vector of limbs that keeps up to two limbs (128 bits) inline.
+ *
+ * Values that fit in 128 bits never touch the heap; larger ones spill to a
+ * buffer from the vector's memory resource on the first growth past the
+ * inline capacity. The resource follows std::pmr container rules: it is
+ * fixed at construction, moves with the buffer on move construction, and is
+ * never changed by assignment. The interface is the subset of std::vector
+ * that bigint needs, with pointer iterators.
+ */
+class limbVector {
+public:
+    static constexpr uint32_t INLINE_LIMBS = 2;
+
+    limbVector() : limbVector(currentResource()) {}
+    explicit limbVector(std::pmr::memory_resource *r) : count(0), cap(INLINE_LIMBS), inlineData{0, 0}, resource(r) {}
+    limbVector(const limbVector &other) : limbVector() {
+        assign(other.begin(), other.end());
+    }
+    limbVector(const limbVector &other, std::pmr::memory_resource *r) : limbVector(r) {
+        assign(other.begin(), other.end());
+    }
+    limbVector(limbVector &&other) noexcept : limbVector(other.resource) {
+        steal(other);
+    }
+    limbVector &operator=(const limbVector &other) {
+        if (this != &other) {
+            assign(other.begin(), other.end());
+        }
+        return *this;
+    }
+    /**
+     * @brief Takes other's buffer when both share a resource, otherwise copies into this one's.
+     */
+    limbVector &operator=(limbVector &&other) {
+        if (this != &other) {
+            if (other.isInline() || resource == other.resource || *resource == *other.resource) {
+                release();
+                steal(other);
+            } else {
+                assign(other.begin(), other.end());
+            }
+        }
+        return *this;
+    }
+    ~limbVector() {
+        release();
+    }
+
+    size_t size() const { return count; }
+    size_t capacity() const { return cap; }
+    bool empty() const { return count == 0; }
+    bool isInline() const { return cap == INLINE_LIMBS; }
+    std::pmr::memory_resource *memoryResource() const { return resource; }
+    limb *data() { return isInline() ? inlineData : heap; }
+    const limb *data() const { return isInline() ? inlineData : heap; }
+    limb *begin() { return data(); }
+    limb *end() { return data() + count; }
+    const limb *begin() const { return data(); }
+    const limb *end() const { return data() + count; }
+    limb &operator[](size_t i) { return data()[i]; }
+    const limb &operator[](size_t i) const { return data()[i]; }
+    limb &back() { return data()[count - 1]; }
+    const limb &back() const { return data()[count - 1]; }
+
+    void clear() { count = 0; }
+    void pop_back() { --count; }
+    void push_back(limb value) {
+        if (count == cap) {
+            reserve(2 * static_cast<size_t>(cap));
+        }
+        data()[count++] = value;
+    }
+    /**
+     * @brief Ensures room for n limbs, keeping the current contents.
+     */
+    void reserve(size_t n) {
+        if (n <= cap) {
+            return;
+        }
+        if (n > UINT32_MAX) {
+            throw std::length_error("bigint exceeds the maximum number of limbs");
+        }
+        limb *fresh = static_cast<limb *>(resource->allocate(n * sizeof(limb), alignof(limb)));
+        recordAllocation(n * sizeof(limb));
+        std::copy(begin(), end(), fresh);
+        release();
+        heap = fresh;
+        cap = static_cast<uint32_t>(n);
+    }
+    /**
+     * @brief Resizes to n limbs; new limbs are set to value.
+     */
+    void resize(size_t n, limb value = 0) {
+        reserve(n);
+        if (n > count) {
+            std::fill(data() + count, data() + n, value);
+        }
+        count = static_cast<uint32_t>(n);
+    }
+    void assign(size_t n, limb value) {
+        count = 0;
+        resize(n, value);
+    }
+    void assign(const limb *first, const limb *last) {
+        size_t n = static_cast<size_t>(last - first);
+        count = 0;
+        reserve(n);
+        std::copy(first, last, data());
+        count = static_cast<uint32_t>(n);
+    }
+    /**
+     * @brief Inserts [first, last) before pos, which must not point into this vector's range being copied.
+     */
+    limb *insert(limb *pos, const limb *first, const limb *last) {
+        size_t offset = static_cast<size_t>(pos - begin());
+        size_t n = static_cast<size_t>(last - first);
+        size_t oldCount = count;
+        resize(oldCount + n);
+        limb *base = data();
+        std::copy_backward(base + offset, base + oldCount, base + oldCount + n);
+        std::copy(first, last, base + offset);
+        return base + offset;
+    }
+    /**
+     * @brief Exchanges contents; each vector keeps its own resource.
+     */
+    void swap(limbVector &other) {
+        limbVector tmp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(tmp);
+    }
+
+    friend bool operator==(const limbVector &a, const limbVector &b) {
+        return a.count == b.count && std::equal(a.begin(), a.end(), b.begin());
+    }
+
+private:
+    uint32_t count;
+    uint32_t cap;
+    union {
+        limb inlineData[INLINE_LIMBS];
+        limb *heap;
+    };
+    std::pmr::memory_resource *resource;
+
+    void release() {
+        if (!isInline()) {
+            resource->deallocate(heap, static_cast<size_t>(cap) * sizeof(limb), alignof(limb));
+            cap = INLINE_LIMBS;
+        }
+    }
+    void steal(limbVector &other) {
+        count = other.count;
+        cap = other.cap;
+        if (other.isInline()) {
+            inlineData[0] = other.inlineData[0];
+            inlineData[1] = other.inlineData[1];
+        } else {
+            heap = other.heap;
+            resource = other.resource;
+            other.cap = INLINE_LIMBS;
+        }
+        other.count = 0;
+    }
+};
+
+/**
+ * @brief Portable r = a + b + carry over n limbs.
+ * @return The carry out of the top limb.
+ */
+inline limb addNGeneric(limb *r, const limb *a, const limb *b, size_t n, limb carry) {
+    for (size_t i = 0; i < n; ++i) {
+        limb s = a[i] + carry;
+        carry = s < carry;
+        s += b[i];
+        carry += s < b[i];
+        r[i] = s;
+    }
+    return carry;
+}
+
+/**
+ * @brief Portable r = a - b - borrow over n limbs.
+ * @return The borrow out of the top limb.
+ */
+inline limb subNGeneric(limb *r, const limb *a, const limb *b, size_t n, limb borrow) {
+    for (size_t i = 0; i < n; ++i) {
+        limb ai = a[i];
+        limb d = ai - b[i];
+        limb borrowOut = ai < b[i];
+        borrowOut += d < borrow;
+        r[i] = d - borrow;
+        borrow = borrowOut;
+    }
+    return borrow;
+}
+
+/**
+ * @brief Portable comparison of two n-limb magnitudes, scanning from the top.
+ * @return -1, 0 or 1 if a is less than, equal to or greater than b.
+ */
+inline int compareNGeneric(const limb *a, const limb *b, size_t n) {
+    while (n > 0) {
+        --n;
+        if (a[n] != b[n]) {
+            return a[n] < b[n] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+#if BIGINT_X86_KERNELS
+/**
+ * @brief r = a + b + carry using the adc instruction, unrolled by four.
+ */
+inline limb addNAdc(limb *r, const limb *a, const limb *b, size_t n, limb carry) {
+    unsigned char c = static_cast<unsigned char>(carry);
+    unsigned long long *out = reinterpret_cast<unsigned long long *>(r);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        c = _addcarry_u64(c, a[i], b[i], out + i);
+        c = _addcarry_u64(c, a[i + 1], b[i + 1], out + i + 1);
+        c = _addcarry_u64(c, a[i + 2], b[i + 2], out + i + 2);
+        c = _addcarry_u64(c, a[i + 3], b[i + 3], out + i + 3);
+    }
+    for (; i < n; ++i) {
+        c = _addcarry_u64(c, a[i], b[i], out + i);
+    }
+    return c;
+}
+
+/**
+ * @brief r = a - b - borrow using the sbb instruction, unrolled by four.
+ */
+inline limb subNAdc(limb *r, const limb *a, const limb *b, size_t n, limb borrow) {
+    unsigned char c = static_cast<unsigned char>(borrow);
+    unsigned long long *out = reinterpret_cast<unsigned long long *>(r);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        c = _subborrow_u64(c, a[i], b[i], out + i);
+        c = _subborrow_u64(c, a[i + 1], b[i + 1], out + i + 1);
+        c = _subborrow_u64(c, a[i + 2], b[i + 2], out + i + 2);
+        c = _subborrow_u64(c, a[i + 3], b[i + 3], out + i + 3);
+    }
+    for (; i < n; ++i) {
+        c = _subborrow_u64(c, a[i], b[i], out + i);
+    }
+    return c;
+}
+
+/**
+ * @brief Compares n-limb magnitudes four limbs at a time from the top with AVX2.
+ */
+__attribute__((target("avx2"))) inline int compareNAvx2(const limb *a, const limb *b, size_t n) {
+    while (n >= 4) {
+        n -= 4;
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + n));
+        __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + n));
+        unsigned eq = static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(x, y))));
+        if (eq != 0xF) {
+            size_t top = n + static_cast<size_t>(31 - __builtin_clz(~eq & 0xF));
+            return a[top] < b[top] ? -1 : 1;
+        }
+    }
+    return compareNGeneric(a, b, n);
+}
+
+/**
+ * @brief r = a + b + carry with AVX-512 carry-lookahead over eight limbs at a time.
+ *
+ * Each block adds lanes independently, then derives per-lane generate (sum
+ * wrapped) and propagate (sum is all ones) masks. Adding the propagate mask
+ * to the shifted generate mask ripples the carries through the block in one
+ * scalar addition, so the loop-carried chain is a few cycles per eight limbs.
+ */
+__attribute__((target("avx512f"))) inline limb addNAvx512(limb *r, const limb *a, const limb *b, size_t n, limb carry) {
+    const __m512i ones = _mm512_set1_epi64(-1);
+    unsigned c = static_cast<unsigned>(carry);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m512i x = _mm512_loadu_si512(a + i);
+        __m512i s = _mm512_add_epi64(x, _mm512_loadu_si512(b + i));
+        unsigned gm = _mm512_cmplt_epu64_mask(s, x);
+        unsigned pm = _mm512_cmpeq_epu64_mask(s, ones);
+        unsigned t = ((gm << 1) | c) + pm;
+        c = t >> 8;
+        s = _mm512_mask_sub_epi64(s, static_cast<__mmask8>(t ^ pm), s, ones);
+        _mm512_storeu_si512(r + i, s);
+    }
+    return addNAdc(r + i, a + i, b + i, n - i, c);
+}
+
+/**
+ * @brief r = a - b - borrow with AVX-512 borrow-lookahead; see addNAvx512.
+ */
+__attribute__((target("avx512f"))) inline limb subNAvx512(limb *r, const limb *a, const limb *b, size_t n, limb borrow) {
+    const __m512i ones = _mm512_set1_epi64(-1);
+    unsigned c = static_cast<unsigned>(borrow);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m512i x = _mm512_loadu_si512(a + i);
+        __m512i y = _mm512_loadu_si512(b + i);
+        __m512i d = _mm512_sub_epi64(x, y);
+        unsigned gm = _mm512_cmplt_epu64_mask(x, y);
+        unsigned pm = _mm512_cmpeq_epu64_mask(d, _mm512_setzero_si512());
+        unsigned t = ((gm << 1) | c) + pm;
+        c = t >> 8;
+        d = _mm512_mask_add_epi64(d, static_cast<__mmask8>(t ^ pm), d, ones);
+        _mm512_storeu_si512(r + i, d);
+    }
+    return subNAdc(r + i, a + i, b + i, n - i, c);
+}
+#endif
+
+/// Instruction sets the add, subtract and compare kernels can be built for.
+enum class simdLevel { generic, adc, avx2, avx512 };
+
+/**
+ * @brief A set of n-limb kernels for one instruction set.
+ */
+struct limbKernels {
+    limb (*add)(limb *, const limb *, const limb *, size_t, limb);
+    limb (*sub)(limb *, const limb *, const limb *, size_t, limb);
+    int (*compare)(const limb *, const limb *, size_t);
+};
+
+/**
+ * @brief Returns the best instruction set this CPU supports, from CPUID.
+ */
+inline simdLevel detectSimd() {
+#if BIGINT_X86_KERNELS
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return simdLevel::avx512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return simdLevel::avx2;
+    }
+    return simdLevel::adc;
+#else
+    return simdLevel::generic;
+#endif
+}
+
+/**
+ * @brief Returns the kernels for level; the caller must check the CPU supports it.
+ *
+ * Four-lane AVX2 carry-lookahead measured no faster than the unrolled adc
+ * loop, so the AVX2 set only vectorizes comparison.
+ */
+inline limbKernels kernelsFor(simdLevel level) {
+#if BIGINT_X86_KERNELS
+    switch (level) {
+    case simdLevel::avx512:
+        return {addNAvx512, subNAvx512, compareNAvx2};
+    case simdLevel::avx2:
+        return {addNAdc, subNAdc, compareNAvx2};
+    case simdLevel::adc:
+        return {addNAdc, subNAdc, compareNGeneric};
+    default:
+        break;
+    }
+#else
+    (void)level;
+#endif
+    return {addNGeneric, subNGeneric, compareNGeneric};
+}
+
+/**
+ * @brief The kernels used by addLimbs, subLimbs and compareLimbs, chosen from CPUID on first use.
+ *
+ * Tests may assign kernelsFor() of any supported level to exercise each variant.
+ */
+inline limbKernels &activeKernels() {
+    static limbKernels kernels = kernelsFor(detectSimd());
+    return kernels;
+}
+
+/// Operands shorter than this skip the dispatched kernels and use the portable loops.
+constexpr size_t SIMD_MIN_LIMBS = 8;
+
+/**
+ * @brief Compares two magnitudes.
+ * @return -1, 0 or 1 if a is less than, equal to or greater than b.
+ */
+inline int compareLimbs(const limb *a, size_t an, const limb *b, size_t bn) {
+    if (an != bn) {
+        return an < bn ? -1 : 1;
+    }
+    if (an < SIMD_MIN_LIMBS) {
+        return compareNGeneric(a, b, an);
+    }
+    return activeKernels().compare(a, b, an);
+}
+
+/**
+ * @brief Computes r = a + b where an >= bn.
+ *
+ * r may be the same array as a or b, but must not otherwise overlap them.
+ * @return The carry out of the top limb (r holds an limbs).
+ */
+inline limb addLimbs(limb *r, const limb *a, size_t an, const limb *b, size_t bn) {
+    limb carry = bn < SIMD_MIN_LIMBS ? addNGeneric(r, a, b, bn, 0) : activeKernels().add(r, a, b, bn, 0);
+    size_t i = bn;
+    for (; i < an && carry != 0; ++i) {
+        limb s = a[i] + carry;
+        carry = s < carry;
+        r[i] = s;
+    }
+    if (r != a) {
+        std::copy(a + i, a + an, r + i);
+    }
+    return carry;
+}
+
+/**
+ * @brief Computes r = a - b where a >= b (so an >= bn).
+ *
+ * r may be the same array as a or b, but must not otherwise overlap them.
+ * @return The borrow out of the top limb; zero when a >= b.
+ */
+inline limb subLimbs(limb *r, const limb *a, size_t an, const limb *b, size_t bn) {
+    limb borrow = bn < SIMD_MIN_LIMBS ? subNGeneric(r, a, b, bn, 0) : activeKernels().sub(r, a, b, bn, 0);
+    size_t i = bn;
+    for (; i < an && borrow != 0; ++i) {
+        limb ai = a[i];
+        r[i] = ai - borrow;
+        borrow = ai < borrow;
+    }
+    if (r != a) {
+        std::copy(a + i, a + an, r + i);
+    }
+    return borrow;
+}
+
+/**
+ * @brief Computes r = a * m for an n-limb a.
+ * @return The carry limb that belongs at r[n].
+ */
+inline limb mulLimb(limb *r, const limb *a, size_t n, limb m) {
+    limb carry = 0;
+    for (size_t i = 0; i < n; ++i) {
+        dlimb p = static_cast<dlimb>(a[i]) * m + carry;
+        r[i] = static_cast<limb>(p);
+        carry = static_cast<limb>(p >> 64);
+    }
+    return carry;
+}
+
+/**
+ * @brief Computes r += a * m over n limbs.
+ * @return The carry limb that belongs at r[n].
+ */
+inline limb addMulLimb(limb *r, const limb *a, size_t n, limb m) {
+    limb carry = 0;
+    for (size_t i = 0; i < n; ++i) {
+        dlimb p = static_cast<dlimb>(a[i]) * m + r[i] + carry;
+        r[i] = static_cast<limb>(p);
+        carry = static_cast<limb>(p >> 64);
+    }
+    return carry;
+}
+
+/**
+ * @brief Schoolbook multiplication r = a * b.
+ *
+ * r must hold an + bn limbs and must not overlap a or b.
+ */
+inline void mulBasecase(limb *r, const limb *a, size_t an, const limb *b, size_t bn) {
+    r[an] = mulLimb(r, a, an, b[0]);
+    for (size_t j = 1; j < bn; ++j) {
+        r[an + j] = addMulLimb(r + j, a, an, b[j]);
+    }
+}
+
+/**
+ * @brief Computes the reciprocal floor((B^2 - 1) / d) - B of a normalized limb d (top bit set).
+ */
+inline limb reciprocalLimb(limb d) {
+    return static_cast<limb>(~static_cast<dlimb>(0) / d);
+}
+
+/**
+ * @brief Divides the two-limb value (u1, u0) by a normalized d using its reciprocal v.
+ *
+ * This is the Moller-Granlund 2/1 division step, which replaces the hardware
+ * 128-by-64 division with two multiplications. Requires u1 < d.
+ * @param rem Receives the remainder.
+ * @return The quotient limb.
+ */
+inline limb divStepPreinv(limb &rem, limb u1, limb u0, limb d, limb v) {
+    dlimb q = static_cast<dlimb>(v) * u1;
+    q += (static_cast<dlimb>(u1 + 1) << 64) | u0;
+    limb q1 = static_cast<limb>(q >> 64);
+    limb q0 = static_cast<limb>(q);
+    limb r = u0 - q1 * d;
+    if (r > q0) {
+        --q1;
+        r += d;
+    }
+    if (r >= d) {
+        ++q1;
+        r -= d;
+    }
+    rem = r;
+    return q1;
+}
+
+/**
+ * @brief Divides an n-limb a by a single non-zero limb d into q (q may alias a, or be null
+ * when only the remainder is needed).
+ * @return The remainder.
+ */
+inline limb divLimb(limb *q, const limb *a, size_t n, limb d) {
+    if (n == 0) {
+        return 0;
+    }
+    unsigned shift = static_cast<unsigned>(__builtin_clzll(d));
+    limb dn = d << shift;
+    limb v = reciprocalLimb(dn);
+    limb rem = 0;
+    if (shift == 0) {
+        while (n > 0) {
+            --n;
+            limb digit = divStepPreinv(rem, rem, a[n], dn, v);
+            if (q != nullptr) {
+                q[n] = digit;
+            }
+        }
+        return rem;
+    }
+    rem = a[n - 1] >> (64 - shift);
+    while (n > 0) {
+        --n;
+        limb u0 = a[n] << shift;
+        if (n > 0) {
+            u0 |= a[n - 1] >> (64 - shift);
+        }
+        limb digit = divStepPreinv(rem, rem, u0, dn, v);
+        if (q != nullptr) {
+            q[n] = digit;
+        }
+    }
+    return rem >> shift;
+}
+
+/**
+ * @brief Computes r = a << bits over n limbs for 0 < bits < 64 (r may alias a).
+ * @return The bits shifted out of the top limb.
+ */
+inline limb shlLimbs(limb *r, const limb *a, size_t n, unsigned bits) {
+    limb out = 0;
+    if (n > 0) {
+        out = a[n - 1] >> (64 - bits);
+    }
+    for (size_t i = n; i > 1; --i) {
+        r[i - 1] = (a[i - 1] << bits) | (a[i - 2] >> (64 - bits));
+    }
+    if (n > 0) {
+        r[0] = a[0] << bits;
+    }
+    return out;
+}
+
+/**
+ * @brief Computes r = a >> bits over n limbs for 0 < bits < 64 (r may alias a).
+ * @return The bits shifted out of the bottom limb, left-aligned.
+ */
+inline limb shrLimbs(limb *r, const limb *a, size_t n, unsigned bits) {
+    limb out = 0;
+    if (n > 0) {
+        out = a[0] << (64 - bits);
+    }
+    for (size_t i = 0; i + 1 < n; ++i) {
+        r[i] = (a[i] >> bits) | (a[i + 1] << (64 - bits));
+    }
+    if (n > 0) {
+        r[n - 1] = a[n - 1] >> bits;
+    }
+    return out;
+}
+
+/**
+ * @brief Schoolbook squaring r = a * a.
+ *
+ * Each cross product a[i] a[j] (i < j) is computed once and the sum doubled
+ * before the squares a[i]^2 are added, so only about half of the n^2 limb
+ * products are needed. r must hold 2n limbs and must not overlap a.
+ */
+inline void sqrBasecase(limb *r, const limb *a, size_t n) {
+    r[0] = 0;
+    r[2 * n - 1] = 0;
+    if (n > 1) {
+        r[n] = mulLimb(r + 1, a + 1, n - 1, a[0]);
+        for (size_t i = 1; i + 1 < n; ++i) {
+            r[n + i] = addMulLimb(r + 2 * i + 1, a + i + 1, n - i - 1, a[i]);
+        }
+        // The cross sum is below B^(2n) / 2, so doubling cannot carry out.
+        shlLimbs(r, r, 2 * n, 1);
+    }
+    limb carry = 0;
+    for (size_t i = 0; i < n; ++i) {
+        dlimb square = static_cast<dlimb>(a[i]) * a[i];
+        dlimb t = static_cast<dlimb>(r[2 * i]) + static_cast<limb>(square) + carry;
+        r[2 * i] = static_cast<limb>(t);
+        t = static_cast<dlimb>(r[2 * i + 1]) + static_cast<limb>(square >> 64) + static_cast<limb>(t >> 64);
+        r[2 * i + 1] = static_cast<limb>(t);
+        carry = static_cast<limb>(t >> 64);
+    }
+}
+
+/**
+ * @brief Computes r -= a * m over n limbs.
+ * @return The borrow to subtract from r[n].
+ */
+inline limb subMulLimb(limb *r, const limb *a, size_t n, limb m) {
+    limb borrow = 0;
+    for (size_t i = 0; i < n; ++i) {
+        dlimb p = static_cast<dlimb>(a[i]) * m + borrow;
+        limb lo = static_cast<limb>(p);
+        borrow = static_cast<limb>(p >> 64);
+        limb ri = r[i];
+        r[i] = ri - lo;
+        borrow += ri < lo;
+    }
+    return borrow;
+}
+
+/**
+ * @brief Knuth Algorithm D: q = a / b and rem = a % b for an >= bn >= 2.
+ *
+ * q receives an - bn + 1 limbs and rem receives bn limbs. Neither may overlap
+ * a or b.
+ */
+inline void divremBasecase(limb *q, limb *rem, const limb *a, size_t an, const limb *b, size_t bn) {
+    unsigned shift = static_cast<unsigned>(__builtin_clzll(b[bn - 1]));
+    limbBuffer v(b, b + bn);
+    limbBuffer u(an + 1);
+    if (shift != 0) {
+        shlLimbs(v.data(), b, bn, shift);
+        u[an] = shlLimbs(u.data(), a, an, shift);
+    } else {
+        std::copy(a, a + an, u.begin());
+    }
+    const limb vTop = v[bn - 1];
+    const limb vNext = v[bn - 2];
+    const limb vInv = reciprocalLimb(vTop);
+
+    for (size_t j = an - bn + 1; j-- > 0;) {
+        limb u2 = u[j + bn];
+        limb u1 = u[j + bn - 1];
+        limb u0 = u[j + bn - 2];
+        limb qhat;
+        limb rhat;
+        bool rhatOverflow = false;
+        if (u2 >= vTop) {
+            qhat = ~limb{0};
+            rhat = u1 + vTop;
+            rhatOverflow = rhat < u1;
+        } else {
+            qhat = divStepPreinv(rhat, u2, u1, vTop, vInv);
+        }
+        while (!rhatOverflow &&
+               static_cast<dlimb>(qhat) * vNext > ((static_cast<dlimb>(rhat) << 64) | u0)) {
+            --qhat;
+            limb old = rhat;
+            rhat += vTop;
+            rhatOverflow = rhat < old;
+        }
+        limb borrow = subMulLimb(u.data() + j, v.data(), bn, qhat);
+        limb top = u[j + bn];
+        u[j + bn] = top - borrow;
+        if (top < borrow) {
+            --qhat;
+            u[j + bn] += addLimbs(u.data() + j, u.data() + j, bn, v.data(), bn);
+        }
+        q[j] = qhat;
+    }
+    if (shift != 0) {
+        shrLimbs(rem, u.data(), bn, shift);
+    } else {
+        std::copy(u.begin(), u.begin() + static_cast<std::ptrdiff_t>(bn), rem);
+    }
+}
+
+/**
+ * @brief Computes r += a over the limbs of r starting at offset, propagating carries.
+ *
+ * The caller guarantees that the true sum fits in rn limbs.
+ */
+inline void addInto(limb *r, size_t rn, size_t offset, const limb *a, size_t an) {
+    while (an > 0 && a[an - 1] == 0) {
+        --an;
+    }
+    if (an == 0) {
+        return;
+    }
+    limb carry = addLimbs(r + offset, r + offset, an, a, an);
+    for (size_t i = offset + an; carry != 0 && i < rn; ++i) {
+        r[i] += carry;
+        carry = r[i] == 0;
+    }
+}
+
+/**
+ * @brief Computes r -= a over the limbs of r starting at offset, propagating borrows.
+ *
+ * The caller guarantees that the true difference is non-negative.
+ */
+inline void subFrom(limb *r, size_t rn, size_t offset, const limb *a, size_t an) {
+    while (an > 0 && a[an - 1] == 0) {
+        --an;
+    }
+    if (an == 0) {
+        return;
+    }
+    limb borrow = subLimbs(r + offset, r + offset, an, a, an);
+    for (size_t i = offset + an; borrow != 0 && i < rn; ++i) {
+        borrow = r[i] == 0;
+        --r[i];
+    }
+}
+
+/**
+ * @brief A fork-join thread pool in which idle threads steal queued tasks from each other.
+ *
+ * Every thread owns a deque: the owner pushes and pops at the back, where the
+ * newest (cache-warm) tasks are, while thieves take the oldest from the front.
+ * A thread waiting in run() keeps executing queued tasks until its own have
+ * finished, so nested forks from inside tasks never deadlock. Queue 0 belongs
+ * to whichever outside thread calls run().
+ */
+class workStealingPool {
+public:
+    explicit workStealingPool(size_t threads) : queues(std::max<size_t>(threads, 1)) {
+        for (size_t i = 1; i < queues.size(); ++i) {
+            workers.emplace_back([this, i] { workerLoop(i); });
+        }
+    }
+    ~workStealingPool() {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread &worker : workers) {
+            worker.join();
+        }
+    }
+    workStealingPool(const workStealingPool &) = delete;
+    workStealingPool &operator=(const workStealingPool &) = delete;
+
+    size_t size() const { return queues.size(); }
+
+    /**
+     * @brief Runs n tasks on the pool and returns once all of them have finished.
+     *
+     * The first task runs on the calling thread. If any task throws, the first
+     * exception is rethrown here after the others complete.
+     */
+    void run(std::function<void()> *tasks, size_t n) {
+        if (n == 0) {
+            return;
+        }
+        joinState state;
+        state.pending.store(n - 1, std::memory_order_relaxed);
+        size_t self = currentIndex();
+        {
+            std::lock_guard<std::mutex> lock(queues[self].mutex);
+            for (size_t i = 1; i < n; ++i) {
+                queues[self].jobs.push_back({&tasks[i], &state});
+            }
+        }
+        queued.fetch_add(n - 1, std::memory_order_release);
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+        }
+        wake.notify_all();
+        execute({&tasks[0], nullptr}, state);
+        while (state.pending.load(std::memory_order_acquire) != 0) {
+            if (!runOne(self)) {
+                std::this_thread::yield();
+            }
+        }
+        if (state.error) {
+            std::rethrow_exception(state.error);
+        }
+    }
+
+private:
+    struct joinState {
+        std::atomic<size_t> pending;
+        std::mutex errorMutex;
+        std::exception_ptr error;
+    };
+    struct job {
+        std::function<void()> *task;
+        joinState *state;
+    };
+    struct workQueue {
+        std::mutex mutex;
+        std::deque<job> jobs;
+    };
+
+    std::deque<workQueue> queues;
+    std::vector<std::thread> workers;
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+    std::atomic<size_t> queued{0};
+    bool stopping = false;
+
+    /**
+     * @brief The calling thread's queue: its own for pool workers, queue 0 for outside threads.
+     */
+    size_t currentIndex() const {
+        return owner() == this ? ownIndex() : 0;
+    }
+    static const workStealingPool *&owner() {
+        static thread_local const workStealingPool *pool = nullptr;
+        return pool;
+    }
+    static size_t &ownIndex() {
+        static thread_local size_t index = 0;
+        return index;
+    }
+
+    static void execute(job j, joinState &state) {
+        try {
+            (*j.task)();
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(state.errorMutex);
+            if (!state.error) {
+                state.error = std::current_exception();
+            }
+        }
+        if (j.state != nullptr) {
+            j.state->pending.fetch_sub(1, std::memory_order_release);
+        }
+    }
+    /**
+     * @brief Runs one queued task, preferring the newest of our own and then stealing the oldest of another's.
+     * @return Whether a task was run.
+     */
+    bool runOne(size_t self) {
+        job j{nullptr, nullptr};
+        {
+            std::lock_guard<std::mutex> lock(queues[self].mutex);
+            if (!queues[self].jobs.empty()) {
+                j = queues[self].jobs.back();
+                queues[self].jobs.pop_back();
+            }
+        }
+        for (size_t k = 1; j.task == nullptr && k < queues.size(); ++k) {
+            workQueue &victim = queues[(self + k) % queues.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.jobs.empty()) {
+                j = victim.jobs.front();
+                victim.jobs.pop_front();
+            }
+        }
+        if (j.task == nullptr) {
+            return false;
+        }
+        queued.fetch_sub(1, std::memory_order_relaxed);
+        execute(j, *j.state);
+        return true;
+    }
+    void workerLoop(size_t index) {
+        owner() = this;
+        ownIndex() = index;
+        for (;;) {
+            if (runOne(index)) {
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            wake.wait(lock, [this] { return stopping || queued.load(std::memory_order_acquire) != 0; });
+            if (stopping) {
+                return;
+            }
+        }
+    }
+};
+
+/**
+ * @brief Returns the shared pool when a product of this size should run in parallel, otherwise null.
+ *
+ * Parallelism needs bigint_tuning::threads > 1 and operands of at least
+ * bigint_tuning::parallelThreshold limbs. It is also skipped inside a
+ * bigint_resource_scope, because an arena resource is not thread-safe. The
+ * pool is rebuilt when the thread count changes, which like the other
+ * tuning values must not happen while multiplications are running.
+ */
+inline workStealingPool *parallelPool(size_t limbs) {
+    size_t threads = bigint_tuning::threads;
+    if (threads <= 1 || limbs < bigint_tuning::parallelThreshold || threadResourceSlot() != nullptr) {
+        return nullptr;
+    }
+    static std::mutex mutex;
+    static std::unique_ptr<workStealingPool> pool;
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!pool || pool->size() != threads) {
+        pool.reset();
+        pool = std::make_unique<workStealingPool>(threads);
+    }
+    return pool.get();
+}
+
+/**
+ * @brief Runs the given callables on pool, or one after another on this thread when pool is null.
+ */
+template <class... F>
+inline void forkJoin(workStealingPool *pool, F &&...tasks) {
+    if (pool == nullptr) {
+        (tasks(), ...);
+        return;
+    }
+    std::function<void()> list[] = {std::function<void()>(std::ref(tasks))...};
+    pool->run(list, sizeof...(F));
+}
+
+/**
+ * @brief All primes up to and including n, in increasing order, by a sieve over the odd numbers.
+ */
+inline std::vector<uint64_t> primesUpTo(uint64_t n) {
+    std::vector<uint64_t> primes;
+    if (n < 2) {
+        return primes;
+    }
+    primes.push_back(2);
+    // composite[i] marks 2 i + 1.
+    std::vector<bool> composite(static_cast<size_t>((n - 1) / 2 + 1));
+    for (uint64_t i = 1; 2 * i + 1 <= n; ++i) {
+        if (composite[static_cast<size_t>(i)]) {
+            continue;
+        }
+        uint64_t p = 2 * i + 1;
+        primes.push_back(p);
+        if (p > n / p) {
+            continue;
+        }
+        for (uint64_t j = p * p / 2; 2 * j + 1 <= n; j += p) {
+            composite[static_cast<size_t>(j)] = true;
+        }
+    }
+    return primes;
+}
+
+/// Primes below this bound are tried by trial division before the probable prime tests.
+constexpr uint64_t TRIAL_PRIME_LIMIT = 1024;
+/// Primes below this bound sieve the candidates of next_prime().
+constexpr uint64_t SIEVE_PRIME_LIMIT = uint64_t{1} << 16;
+
+/**
+ * @brief Consecutive small primes whose product fits in one limb.
+ *
+ * One single-limb division of a bigint by the product gives its residues
+ * modulo all primes of the group.
+ */
+struct primeGroup {
+    limb product;
+    size_t first;
+    size_t count;
+};
+
+/**
+ * @brief The primes below SIEVE_PRIME_LIMIT, computed once.
+ */
+inline const std::vector<uint64_t> &smallPrimes() {
+    static const std::vector<uint64_t> primes = primesUpTo(SIEVE_PRIME_LIMIT - 1);
+    return primes;
+}
+
+/**
+ * @brief smallPrimes() packed into primeGroup entries, computed once.
+ */
+inline const std::vector<primeGroup> &smallPrimeGroups() {
+    static const std::vector<primeGroup> groups = [] {
+        const std::vector<uint64_t> &primes = smallPrimes();
+        std::vector<primeGroup> res;
+        for (size_t i = 0; i < primes.size();) {
+            primeGroup group{1, i, 0};
+            while (i < primes.size() && group.product <= ~limb{0} / primes[i]) {
+                group.product *= primes[i++];
+                ++group.count;
+            }
+            res.push_back(group);
+        }
+        return res;
+    }();
+    return groups;
+}
+
+inline limb mulmodWord(limb a, limb b, limb m) {
+    return static_cast<limb>(static_cast<dlimb>(a) * b % m);
+}
+
+inline limb powmodWord(limb base, limb exponent, limb m) {
+    limb res = 1 % m;
+    base %= m;
+    while (exponent > 0) {
+        if (exponent & 1) {
+            res = mulmodWord(res, base, m);
+        }
+        base = mulmodWord(base, base, m);
+        exponent >>= 1;
+    }
+    return res;
+}
+
+/**
+ * @brief Exact primality of a single limb by Miller-Rabin with a base set that has no 64-bit pseudoprime.
+ */
+inline bool isPrimeWord(limb n) {
+    if (n < 2) {
+        return false;
+    }
+    for (limb p : {2ULL, 3ULL, 5ULL, 7ULL, 11ULL, 13ULL, 17ULL, 19ULL, 23ULL, 29ULL, 31ULL, 37ULL}) {
+        if (n % p == 0) {
+            return n == p;
+        }
+    }
+    if (n < 41 * 41) {
+        return true;
+    }
+    limb d = n - 1;
+    int s = std::countr_zero(d);
+    d >>= s;
+    for (limb base : {2ULL, 325ULL, 9375ULL, 28178ULL, 450775ULL, 9780504ULL, 1795265022ULL}) {
+        limb x = powmodWord(base, d, n);
+        if (x == 0 || x == 1 || x == n - 1) {
+            continue;
+        }
+        bool witness = true;
+        for (int r = 1; r < s && witness; ++r) {
+            x = mulmodWord(x, x, n);
+            witness = x != n - 1;
+        }
+        if (witness) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief The Jacobi symbol (a / n) for odd n.
+ */
+inline int jacobiWord(limb a, limb n) {
+    int res = 1;
+    a %= n;
+    while (a != 0) {
+        int twos = std::countr_zero(a);
+        a >>= twos;
+        if ((twos & 1) != 0 && (n % 8 == 3 || n % 8 == 5)) {
+            res = -res;
+        }
+        if (a % 4 == 3 && n % 4 == 3) {
+            res = -res;
+        }
+        std::swap(a, n);
+        a %= n;
+    }
+    return n == 1 ? res : 0;
+}
+
+/**
+ * @brief Per-thread generator for Miller-Rabin bases and random primes, seeded from std::random_device.
+ */
+inline std::mt19937_64 &primeRandom() {
+    thread_local std::mt19937_64 rng(std::random_device{}());
+    return rng;
+}
+
+inline void mulLimbs(limb *r, const limb *a, size_t an, const limb *b, size_t bn);
+
+/**
+ * @brief Returns a * b as a freshly allocated limb vector (high zero limbs trimmed).
+ */
+inline limbBuffer mulVectors(const limbBuffer &a, const limbBuffer &b) {
+    limbBuffer r;
+    if (a.empty() || b.empty()) {
+        return r;
+    }
+    r.resize(a.size() + b.size());
+    mulLimbs(r.data(), a.data(), a.size(), b.data(), b.size());
+    while (!r.empty() && r.back() == 0) {
+        r.pop_back();
+    }
+    return r;
+}
+
+/**
+ * @brief Copies n limbs starting at a into a vector, dropping high zero limbs.
+ */
+inline limbBuffer trimmedCopy(const limb *a, size_t n) {
+    while (n > 0 && a[n - 1] == 0) {
+        --n;
+    }
+    return limbBuffer(a, a + n);
+}
+
+/**
+ * @brief Karatsuba multiplication r = a * b for bn <= an < 2 * bn.
+ *
+ * Splits both operands at half the length of a; the middle product is
+ * recovered from (a0 + a1)(b0 + b1) - a0 b0 - a1 b1. r must hold an + bn limbs.
+ */
+inline void mulKaratsuba(limb *r, const limb *a, size_t an, const limb *b, size_t bn) {
+    size_t m = (an + 1) / 2;
+    size_t a1n = an - m;
+    size_t b1n = bn - m;
+
+    limbBuffer sa(m + 1);
+    sa[m] = addLimbs(sa.data(), a, m, a + m, a1n);
+    limbBuffer sb(m + 1);
+    sb[m] = addLimbs(sb.data(), b, m, b + m, b1n);
+    while (!sa.empty() && sa.back() == 0) {
+        sa.pop_back();
+    }
+    while (!sb.empty() && sb.back() == 0) {
+        sb.pop_back();
+    }
+
+    limbBuffer z0, z1, z2;
+    forkJoin(parallelPool(bn),
+             [&] { z0 = mulVectors(trimmedCopy(a, m), trimmedCopy(b, m)); },
+             [&] {
+                 if (b1n > 0) {
+                     z2.resize(a1n + b1n);
+                     mulLimbs(z2.data(), a + m, a1n, b + m, b1n);
+                 }
+             },
+             [&] { z1 = mulVectors(sa, sb); });
+
+    std::fill(r, r + an + bn, limb{0});
+    std::copy(z0.begin(), z0.end(), r);
+    std::copy(z2.begin(), z2.end(), r + 2 * m);
+    subFrom(z1.data(), z1.size(), 0, z0.data(), z0.size());
+    subFrom(z1.data(), z1.size(), 0, z2.data(), z2.size());
+    addInto(r, an + bn, m, z1.data(), z1.size());
+}
+
+/**
+ * @brief Karatsuba squaring r = a * a.
+ *
+ * Uses the middle term a0^2 + a1^2 - (a0 - a1)^2, so all three subproducts
+ * are squares again and recurse into the squaring kernels. r must hold 2n limbs.
+ */
+inline void sqrKaratsuba(limb *r, const limb *a, size_t n) {
+    size_t m = (n + 1) / 2;
+    limbBuffer lo = trimmedCopy(a, m);
+    limbBuffer hi = trimmedCopy(a + m, n - m);
+    bool loBigger = compareLimbs(lo.data(), lo.size(), hi.data(), hi.size()) >= 0;
+    const limbBuffer &big = loBigger ? lo : hi;
+    const limbBuffer &small = loBigger ? hi : lo;
+    limbBuffer diff(big.size());
+    subLimbs(diff.data(), big.data(), big.size(), small.data(), small.size());
+    while (!diff.empty() && diff.back() == 0) {
+        diff.pop_back();
+    }
+
+    limbBuffer z0, z1, z2;
+    forkJoin(parallelPool(n),
+             [&] { z0 = mulVectors(lo, lo); },
+             [&] { z2 = mulVectors(hi, hi); },
+             [&] { z1 = mulVectors(diff, diff); });
+
+    std::fill(r, r + 2 * n, limb{0});
+    std::copy(z0.begin(), z0.end(), r);
+    std::copy(z2.begin(), z2.end(), r + 2 * m);
+    addInto(r, 2 * n, m, z0.data(), z0.size());
+    addInto(r, 2 * n, m, z2.data(), z2.size());
+    subFrom(r, 2 * n, m, z1.data(), z1.size());
+}
+
+/**
+ * @brief A signed magnitude used for the evaluation points of Toom-Cook.
+ */
+struct signedLimbs {
+    limbBuffer mag;
+    bool negative = false;
+};
+
+/**
+ * @brief Computes x += (yNegative ? -y : y) on signed magnitudes.
+ */
+inline void addSignedLimbs(signedLimbs &x, const limb *y, size_t yn, bool yNegative) {
+    while (yn > 0 && y[yn - 1] == 0) {
+        --yn;
+    }
+    if (x.negative == yNegative || x.mag.empty()) {
+        if (x.mag.empty()) {
+            x.negative = yNegative;
+        }
+        size_t xn = x.mag.size();
+        if (xn >= yn) {
+            x.mag.push_back(addLimbs(x.mag.data(), x.mag.data(), xn, y, yn));
+        } else {
+            x.mag.resize(yn + 1);
+            x.mag[yn] = addLimbs(x.mag.data(), y, yn, x.mag.data(), xn);
+        }
+    } else {
+        int cmp = compareLimbs(x.mag.data(), x.mag.size(), y, yn);
+        if (cmp >= 0) {
+            subLimbs(x.mag.data(), x.mag.data(), x.mag.size(), y, yn);
+        } else {
+            size_t xn = x.mag.size();
+            x.mag.resize(yn);
+            limbBuffer tmp(y, y + yn);
+            subLimbs(x.mag.data(), tmp.data(), yn, x.mag.data(), xn);
+            x.negative = yNegative;
+        }
+    }
+    while (!x.mag.empty() && x.mag.back() == 0) {
+        x.mag.pop_back();
+    }
+    if (x.mag.empty()) {
+        x.negative = false;
+    }
+}
+
+/**
+ * @brief Shifts a signed magnitude left by bits (< 64) in place.
+ */
+inline void shiftLeftSmall(signedLimbs &x, unsigned bits) {
+    limb carry = 0;
+    for (limb &v : x.mag) {
+        limb next = v >> (64 - bits);
+        v = (v << bits) | carry;
+        carry = next;
+    }
+    if (carry != 0) {
+        x.mag.push_back(carry);
+    }
+}
+
+/**
+ * @brief Divides a signed magnitude exactly by a small divisor in place.
+ */
+inline void divideExact(signedLimbs &x, limb d) {
+    divLimb(x.mag.data(), x.mag.data(), x.mag.size(), d);
+    while (!x.mag.empty() && x.mag.back() == 0) {
+        x.mag.pop_back();
+    }
+}
+
+/**
+ * @brief Evaluates the 3-piece polynomial p(x) = p0 + p1 x + p2 x^2 at 1, -1 and -2.
+ */
+inline void toom3Evaluate(const limb *p, size_t pn, size_t k,
+                          signedLimbs &at1, signedLimbs &atMinus1, signedLimbs &atMinus2) {
+    const limb *p0 = p;
+    size_t p0n = std::min(k, pn);
+    const limb *p1 = p + p0n;
+    size_t p1n = pn > k ? std::min(k, pn - k) : 0;
+    const limb *p2 = p + p0n + p1n;
+    size_t p2n = pn > 2 * k ? pn - 2 * k : 0;
+
+    signedLimbs even;
+    addSignedLimbs(even, p0, p0n, false);
+    addSignedLimbs(even, p2, p2n, false);
+    at1 = even;
+    addSignedLimbs(at1, p1, p1n, false);
+    atMinus1 = even;
+    addSignedLimbs(atMinus1, p1, p1n, true);
+    // p(-2) = 2 (p(-1) + p2) - p0
+    atMinus2 = atMinus1;
+    addSignedLimbs(atMinus2, p2, p2n, false);
+    shiftLeftSmall(atMinus2, 1);
+    addSignedLimbs(atMinus2, p0, p0n, true);
+}
+
+/**
+ * @brief Multiplies two signed magnitudes.
+ */
+inline signedLimbs mulSigned(const signedLimbs &x, const signedLimbs &y) {
+    signedLimbs r;
+    r.mag = mulVectors(x.mag, y.mag);
+    r.negative = !r.mag.empty() && x.negative != y.negative;
+    return r;
+}
+
+inline void toom3Interpolate(limb *r, size_t rn, size_t k, signedLimbs &r0, signedLimbs &r1,
+                             signedLimbs &rm1, signedLimbs &r3, signedLimbs &rinf);
+
+/**
+ * @brief Toom-3 multiplication r = a * b for bn <= an < 2 * bn.
+ *
+ * Evaluates at 0, 1, -1, -2 and infinity and interpolates with Bodrato's
+ * sequence. r must hold an + bn limbs.
+ */
+inline void mulToom3(limb *r, const limb *a, size_t an, const limb *b, size_t bn) {
+    size_t k = (an + 2) / 3;
+    size_t b2n = bn > 2 * k ? bn - 2 * k : 0;
+
+    signedLimbs a1, am1, am2, b1, bm1, bm2;
+    toom3Evaluate(a, an, k, a1, am1, am2);
+    toom3Evaluate(b, bn, k, b1, bm1, bm2);
+
+    signedLimbs r0, rinf, r1, rm1, r3;
+    forkJoin(parallelPool(bn),
+             [&] { r0.mag = mulVectors(trimmedCopy(a, k), trimmedCopy(b, std::min(k, bn))); },
+             [&] {
+                 if (b2n > 0) {
+                     rinf.mag = mulVectors(trimmedCopy(a + 2 * k, an - 2 * k), trimmedCopy(b + 2 * k, b2n));
+                 }
+             },
+             [&] { r1 = mulSigned(a1, b1); },
+             [&] { rm1 = mulSigned(am1, bm1); },
+             [&] { r3 = mulSigned(am2, bm2); });
+    toom3Interpolate(r, an + bn, k, r0, r1, rm1, r3, rinf);
+}
+
+/**
+ * @brief Toom-3 squaring r = a * a.
+ *
+ * Evaluates a once instead of twice, and the five pointwise products are
+ * squares that recurse into the squaring kernels. r must hold 2n limbs.
+ */
+inline void sqrToom3(limb *r, const limb *a, size_t n) {
+    size_t k = (n + 2) / 3;
+    signedLimbs a1, am1, am2;
+    toom3Evaluate(a, n, k, a1, am1, am2);
+
+    signedLimbs r0, rinf, r1, rm1, r3;
+    forkJoin(parallelPool(n),
+             [&] {
+                 limbBuffer lo = trimmedCopy(a, k);
+                 r0.mag = mulVectors(lo, lo);
+             },
+             [&] {
+                 if (n > 2 * k) {
+                     limbBuffer hi = trimmedCopy(a + 2 * k, n - 2 * k);
+                     rinf.mag = mulVectors(hi, hi);
+                 }
+             },
+             [&] { r1 = mulSigned(a1, a1); },
+             [&] { rm1 = mulSigned(am1, am1); },
+             [&] { r3 = mulSigned(am2, am2); });
+    toom3Interpolate(r, 2 * n, k, r0, r1, rm1, r3, rinf);
+}
+
+/**
+ * @brief Interpolates the Toom-3 values r(0), r(1), r(-1), r(-2) and r(inf) into r (rn limbs).
+ *
+ * Uses Bodrato's sequence; the value arguments are overwritten.
+ */
+inline void toom3Interpolate(limb *r, size_t rn, size_t k, signedLimbs &r0, signedLimbs &r1,
+                             signedLimbs &rm1, signedLimbs &r3, signedLimbs &rinf) {
+    // r3 = (r(-2) - r(1)) / 3
+    addSignedLimbs(r3, r1.mag.data(), r1.mag.size(), !r1.negative);
+    divideExact(r3, 3);
+    // r1 = (r(1) - r(-1)) / 2
+    addSignedLimbs(r1, rm1.mag.data(), rm1.mag.size(), !rm1.negative);
+    divideExact(r1, 2);
+    // r2 = r(-1) - r(0)
+    signedLimbs r2 = rm1;
+    addSignedLimbs(r2, r0.mag.data(), r0.mag.size(), true);
+    // r3 = (r2 - r3) / 2 + 2 r(inf)
+    signedLimbs t = r2;
+    addSignedLimbs(t, r3.mag.data(), r3.mag.size(), !r3.negative);
+    divideExact(t, 2);
+    r3 = t;
+    addSignedLimbs(r3, rinf.mag.data(), rinf.mag.size(), false);
+    addSignedLimbs(r3, rinf.mag.data(), rinf.mag.size(), false);
+    // r2 = r2 + r1 - r(inf)
+    addSignedLimbs(r2, r1.mag.data(), r1.mag.size(), r1.negative);
+    addSignedLimbs(r2, rinf.mag.data(), rinf.mag.size(), true);
+    // r1 = r1 - r3
+    addSignedLimbs(r1, r3.mag.data(), r3.mag.size(), !r3.negative);
+
+    std::fill(r, r + rn, limb{0});
+    std::copy(r0.mag.begin(), r0.mag.end(), r);
+    addInto(r, rn, 4 * k, rinf.mag.data(), rinf.mag.size());
+    addInto(r, rn, k, r1.mag.data(), r1.mag.size());
+    addInto(r, rn, 2 * k, r2.mag.data(), r2.mag.size());
+    addInto(r, rn, 3 * k, r3.mag.data(), r3.mag.size());
+}
+
+/**
+ * @brief Multiplies an unbalanced pair (an >= 2 * bn) by slicing a into bn-limb blocks.
+ */
+inline void mulUnbalanced(limb *r, const limb *a, size_t an, const limb *b, size_t bn) {
+    size_t rn = an + bn;
+    std::fill(r, r + rn, limb{0});
+    limbBuffer block(2 * bn);
+    for (size_t offset = 0; offset < an; offset += bn) {
+        size_t len = std::min(bn, an - offset);
+        mulLimbs(block.data(), a + offset, len, b, bn);
+        addInto(r, rn, offset, block.data(), len + bn);
+    }
+}
+
+/**
+ * @brief Number-theoretic transform over the prime field Z/PZ.
+ * @tparam P A prime of the form c * 2^k + 1 below 2^31.
+ * @tparam G A primitive root modulo P.
+ */
+template <uint32_t P, uint32_t G>
+struct nttPrime {
+    static constexpr uint32_t MOD = P;
+
+    static uint32_t mul(uint32_t a, uint32_t b) {
+        return static_cast<uint32_t>(static_cast<uint64_t>(a) * b % P);
+    }
+    static uint32_t add(uint32_t a, uint32_t b) {
+        uint32_t s = a + b;
+        return s >= P ? s - P : s;
+    }
+    static uint32_t sub(uint32_t a, uint32_t b) {
+        return a >= b ? a - b : a + P - b;
+    }
+    static uint32_t power(uint32_t base, uint64_t e) {
+        uint32_t res = 1;
+        while (e > 0) {
+            if (e & 1) {
+                res = mul(res, base);
+            }
+            base = mul(base, base);
+            e >>= 1;
+        }
+        return res;
+    }
+    /**
+     * @brief Fills roots[len + j] with w_{2 len}^j for every power-of-two len < n.
+     *
+     * Both directions share the table: w_{2 len}^-j = -w_{2 len}^(len - j).
+     */
+    static scratchVector<uint32_t> rootTable(size_t n) {
+        scratchVector<uint32_t> roots(std::max<size_t>(n, 2));
+        for (size_t len = 1; len < n; len <<= 1) {
+            uint32_t w = power(G, (P - 1) / (2 * len));
+            uint32_t cur = 1;
+            for (size_t j = 0; j < len; ++j) {
+                roots[len + j] = cur;
+                cur = mul(cur, w);
+            }
+        }
+        return roots;
+    }
+    /**
+     * @brief Decimation-in-frequency transform; leaves a in bit-reversed order.
+     */
+    static void forward(uint32_t *a, size_t n, const uint32_t *roots) {
+        for (size_t len = n / 2; len >= 1; len >>= 1) {
+            for (size_t i = 0; i < n; i += 2 * len) {
+                for (size_t j = 0; j < len; ++j) {
+                    uint32_t u = a[i + j];
+                    uint32_t v = a[i + j + len];
+                    a[i + j] = add(u, v);
+                    a[i + j + len] = mul(sub(u, v), roots[len + j]);
+                }
+            }
+        }
+    }
+    /**
+     * @brief Decimation-in-time inverse transform from bit-reversed order, including the 1/n scale.
+     */
+    static void inverse(uint32_t *a, size_t n, const uint32_t *roots) {
+        for (size_t len = 1; len < n; len <<= 1) {
+            for (size_t i = 0; i < n; i += 2 * len) {
+                uint32_t u = a[i];
+                uint32_t v = a[i + len];
+                a[i] = add(u, v);
+                a[i + len] = sub(u, v);
+                for (size_t j = 1; j < len; ++j) {
+                    // v = -a[i + j + len] * w^-j, so the butterfly signs swap.
+                    u = a[i + j];
+                    v = mul(a[i + j + len], roots[2 * len - j]);
+                    a[i + j] = sub(u, v);
+                    a[i + j + len] = add(u, v);
+                }
+            }
+        }
+        uint32_t scale = power(static_cast<uint32_t>(n % P), P - 2);
+        for (size_t i = 0; i < n; ++i) {
+            a[i] = mul(a[i], scale);
+        }
+    }
+    /**
+     * @brief Cyclic convolution of two 32-bit digit sequences modulo P.
+     *
+     * One root table serves every transform of the call. When x and y are the
+     * same sequence (squaring) it is transformed only once.
+     */
+    static scratchVector<uint32_t> convolve(const scratchVector<uint32_t> &x, const scratchVector<uint32_t> &y, size_t n) {
+        scratchVector<uint32_t> roots = rootTable(n);
+        scratchVector<uint32_t> fx(n, 0);
+        for (size_t i = 0; i < x.size(); ++i) {
+            fx[i] = x[i] % P;
+        }
+        if (&x == &y) {
+            forward(fx.data(), n, roots.data());
+            for (size_t i = 0; i < n; ++i) {
+                fx[i] = mul(fx[i], fx[i]);
+            }
+            inverse(fx.data(), n, roots.data());
+            return fx;
+        }
+        scratchVector<uint32_t> fy(n, 0);
+        for (size_t i = 0; i < y.size(); ++i) {
+            fy[i] = y[i] % P;
+        }
+        forkJoin(parallelPool(n / 4), [&] { forward(fx.data(), n, roots.data()); }, [&] { forward(fy.data(), n, roots.data()); });
+        for (size_t i = 0; i < n; ++i) {
+            fx[i] = mul(fx[i], fy[i]);
+        }
+        inverse(fx.data(), n, roots.data());
+        return fx;
+    }
+};
+
+using nttPrime0 = nttPrime<2013265921u, 31u>;
+using nttPrime1 = nttPrime<469762049u, 3u>;
+using nttPrime2 = nttPrime<1811939329u, 13u>;
+
+/// Longest supported transform (limited by 2^26 | P - 1 for all three primes).
+constexpr size_t NTT_MAX_LENGTH = size_t{1} << 26;
+/// Largest an + bn (in limbs) whose product fits in one transform of 32-bit digits.
+constexpr size_t NTT_MAX_LIMBS = NTT_MAX_LENGTH / 2;
+
+/**
+ * @brief Splits n limbs into 2n little-endian 32-bit digits.
+ */
+inline scratchVector<uint32_t> splitHalfLimbs(const limb *a, size_t n) {
+    scratchVector<uint32_t> res(2 * n);
+    for (size_t i = 0; i < n; ++i) {
+        res[2 * i] = static_cast<uint32_t>(a[i]);
+        res[2 * i + 1] = static_cast<uint32_t>(a[i] >> 32);
+    }
+    return res;
+}
+
+/**
+ * @brief Multiplies via three-prime NTT and Garner CRT reconstruction.
+ *
+ * Works on 32-bit digits; each convolution term is below 2^90, which the
+ * product of the three primes (about 2^90.47) recovers exactly. r must hold
+ * an + bn limbs and an + bn must not exceed NTT_MAX_LIMBS.
+ */
+inline void mulNtt(limb *r, const limb *a, size_t an, const limb *b, size_t bn) {
+    bool squaring = a == b && an == bn;
+    scratchVector<uint32_t> x = splitHalfLimbs(a, an);
+    scratchVector<uint32_t> other = squaring ? scratchVector<uint32_t>() : splitHalfLimbs(b, bn);
+    // Passing the same digits twice lets convolve() transform them once.
+    const scratchVector<uint32_t> &y = squaring ? x : other;
+    size_t digits = x.size() + y.size();
+    size_t n = 1;
+    while (n < digits) {
+        n <<= 1;
+    }
+    scratchVector<uint32_t> c0, c1, c2;
+    forkJoin(parallelPool(bn),
+             [&] { c0 = nttPrime0::convolve(x, y, n); },
+             [&] { c1 = nttPrime1::convolve(x, y, n); },
+             [&] { c2 = nttPrime2::convolve(x, y, n); });
+
+    constexpr uint64_t p0 = nttPrime0::MOD;
+    constexpr uint64_t p1 = nttPrime1::MOD;
+    constexpr uint64_t p2 = nttPrime2::MOD;
+    const uint32_t inv01 = nttPrime1::power(static_cast<uint32_t>(p0 % p1), p1 - 2);
+    const uint32_t p01mod2 = static_cast<uint32_t>(p0 % p2 * (p1 % p2) % p2);
+    const uint32_t inv012 = nttPrime2::power(p01mod2, p2 - 2);
+
+    dlimb carry = 0;
+    for (size_t i = 0; i < digits; ++i) {
+        // x = c0 + p0 k1 + p0 p1 k2 with k1 < p1 and k2 < p2.
+        uint32_t k1 = nttPrime1::mul(nttPrime1::sub(c1[i], static_cast<uint32_t>(c0[i] % p1)), inv01);
+        uint64_t partial = (c0[i] + p0 * k1) % p2;
+        uint32_t k2 = nttPrime2::mul(nttPrime2::sub(c2[i], static_cast<uint32_t>(partial)), inv012);
+        carry += c0[i] + static_cast<dlimb>(p0) * k1 + static_cast<dlimb>(p0 * p1) * k2;
+        uint32_t digit = static_cast<uint32_t>(carry);
+        carry >>= 32;
+        if (i % 2 == 0) {
+            r[i / 2] = digit;
+        } else {
+            r[i / 2] |= static_cast<limb>(digit) << 32;
+        }
+    }
+}
+
+/**
+ * @brief Squares an n-limb magnitude, choosing the algorithm by size.
+ *
+ * Squaring kernels are charged to the same bigint_stats tiers as products.
+ * r must hold 2n limbs and must not overlap a; n must be non-zero.
+ */
+inline void sqrLimbs(limb *r, const limb *a, size_t n) {
+    if (n < std::max<size_t>(bigint_tuning::sqrKaratsubaThreshold, 4)) {
+        tierTimer timer(bigint_tier::mulBasecase);
+        sqrBasecase(r, a, n);
+    } else if (n < std::max<size_t>(bigint_tuning::sqrToom3Threshold, 4)) {
+        tierTimer timer(bigint_tier::mulKaratsuba);
+        sqrKaratsuba(r, a, n);
+    } else if (n < bigint_tuning::sqrNttThreshold || 2 * n > NTT_MAX_LIMBS) {
+        tierTimer timer(bigint_tier::mulToom3);
+        sqrToom3(r, a, n);
+    } else {
+        tierTimer timer(bigint_tier::mulNtt);
+        mulNtt(r, a, n, a, n);
+    }
+}
+
+/**
+ * @brief Multiplies two magnitudes, choosing the algorithm by operand size.
+ *
+ * Identical operands (same pointer and size) are squared by sqrLimbs().
+ * r must hold an + bn limbs and must not overlap a or b. Both sizes must be non-zero.
+ */
+inline void mulLimbs(limb *r, const limb *a, size_t an, const limb *b, size_t bn) {
+    if (a == b && an == bn) {
+        sqrLimbs(r, a, an);
+        return;
+    }
+    if (an < bn) {
+        std::swap(a, b);
+        std::swap(an, bn);
+    }
+    // Karatsuba and Toom-3 only shrink their subproducts from 4 limbs upwards.
+    if (bn < std::max<size_t>(bigint_tuning::karatsubaThreshold, 4)) {
+        tierTimer timer(bigint_tier::mulBasecase);
+        mulBasecase(r, a, an, b, bn);
+    } else if (an >= 2 * bn) {
+        mulUnbalanced(r, a, an, b, bn);
+    } else if (bn < std::max<size_t>(bigint_tuning::toom3Threshold, 4)) {
+        tierTimer timer(bigint_tier::mulKaratsuba);
+        mulKaratsuba(r, a, an, b, bn);
+    } else if (bn < bigint_tuning::nttThreshold || an + bn > NTT_MAX_LIMBS) {
+        tierTimer timer(bigint_tier::mulToom3);
+        mulToom3(r, a, an, b, bn);
+    } else {
+        tierTimer timer(bigint_tier::mulNtt);
+        mulNtt(r, a, an, b, bn);
+    }
+}
+
+} // namespace bigint_detail
+
+/**
+ * @brief A snapshot of the instrumentation counters.
+ *
+ * Counting is off by default: define BIGINT_INSTRUMENTATION to 1 before
+ * including bigint.hpp to enable it. Otherwise every hook compiles away and
+ * snapshots stay zero. Counters are process-wide and safe to update from any
+ * thread. Operators used internally (e.g. by Newton division) are counted too.
+ */
+struct bigint_stats {
+    /// Whether this build collects statistics.
+    static constexpr bool enabled = BIGINT_INSTRUMENTATION != 0;
+    static constexpr size_t SIZE_BUCKETS = bigint_detail::SIZE_BUCKETS;
+
+    /// Calls per operation, indexed by bigint_op.
+    std::array<uint64_t, bigint_detail::OP_COUNT> calls{};
+    /// Per operation, calls whose larger operand has 2^(k-1) to 2^k - 1 limbs in bucket k (zero in bucket 0).
+    std::array<std::array<uint64_t, SIZE_BUCKETS>, bigint_detail::OP_COUNT> sizes{};
+    /// Runs of each algorithm tier, indexed by bigint_tier.
+    std::array<uint64_t, bigint_detail::TIER_COUNT> tierCalls{};
+    /// Exclusive nanoseconds spent in each algorithm tier.
+    std::array<uint64_t, bigint_detail::TIER_COUNT> tierNanos{};
+    /// Heap blocks requested for limb storage and kernel scratch buffers.
+    uint64_t allocations = 0;
+    /// Bytes requested by those allocations.
+    uint64_t bytesAllocated = 0;
+
+    uint64_t count(bigint_op op) const {
+        return calls[static_cast<size_t>(op)];
+    }
+    uint64_t count(bigint_tier tier) const {
+        return tierCalls[static_cast<size_t>(tier)];
+    }
+    uint64_t nanos(bigint_tier tier) const {
+        return tierNanos[static_cast<size_t>(tier)];
+    }
+
+    /**
+     * @brief Reads the current counters.
+     */
+    static bigint_stats snapshot() {
+        bigint_stats res;
+#if BIGINT_INSTRUMENTATION
+        const bigint_detail::statsCounters &c = bigint_detail::statsStorage;
+        for (size_t i = 0; i < bigint_detail::OP_COUNT; ++i) {
+            res.calls[i] = c.calls[i].load(std::memory_order_relaxed);
+            for (size_t k = 0; k < SIZE_BUCKETS; ++k) {
+                res.sizes[i][k] = c.sizes[i][k].load(std::memory_order_relaxed);
+            }
+        }
+        for (size_t i = 0; i < bigint_detail::TIER_COUNT; ++i) {
+            res.tierCalls[i] = c.tierCalls[i].load(std::memory_order_relaxed);
+            res.tierNanos[i] = c.tierNanos[i].load(std::memory_order_relaxed);
+        }
+        res.allocations = c.allocations.load(std::memory_order_relaxed);
+        res.bytesAllocated = c.bytesAllocated.load(std::memory_order_relaxed);
+#endif
+        return res;
+    }
+    /**
+     * @brief Sets every counter back to zero.
+     */
+    static void reset() {
+#if BIGINT_INSTRUMENTATION
+        bigint_detail::statsCounters &c = bigint_detail::statsStorage;
+        for (size_t i = 0; i < bigint_detail::OP_COUNT; ++i) {
+            c.calls[i].store(0, std::memory_order_relaxed);
+            for (size_t k = 0; k < SIZE_BUCKETS; ++k) {
+                c.sizes[i][k].store(0, std::memory_order_relaxed);
+            }
+        }
+        for (size_t i = 0; i < bigint_detail::TIER_COUNT; ++i) {
+            c.tierCalls[i].store(0, std::memory_order_relaxed);
+            c.tierNanos[i].store(0, std::memory_order_relaxed);
+        }
+        c.allocations.store(0, std::memory_order_relaxed);
+        c.bytesAllocated.store(0, std::memory_order_relaxed);
+#endif
+    }
+    /**
+     * @brief Counters accumulated since an earlier snapshot.
+     */
+    bigint_stats since(const bigint_stats &earlier) const {
+        bigint_stats res = *this;
+        for (size_t i = 0; i < bigint_detail::OP_COUNT; ++i) {
+            res.calls[i] -= earlier.calls[i];
+            for (size_t k = 0; k < SIZE_BUCKETS; ++k) {
+                res.sizes[i][k] -= earlier.sizes[i][k];
+            }
+        }
+        for (size_t i = 0; i < bigint_detail::TIER_COUNT; ++i) {
+            res.tierCalls[i] -= earlier.tierCalls[i];
+            res.tierNanos[i] -= earlier.tierNanos[i];
+        }
+        res.allocations -= earlier.allocations;
+        res.bytesAllocated -= earlier.bytesAllocated;
+        return res;
+    }
+    static const char *name(bigint_op op) {
+        static const char *const names[] = {"add", "sub", "mul", "div", "mod", "compare",
+                                            "parse", "print", "reduce", "mulmod", "powmod"};
+        return names[static_cast<size_t>(op)];
+    }
+    static const char *name(bigint_tier tier) {
+        static const char *const names[] = {"mul_basecase", "mul_karatsuba", "mul_toom3", "mul_ntt",
+                                            "div_basecase", "div_newton", "reciprocal",
+                                            "print_basecase", "parse_basecase"};
+        return names[static_cast<size_t>(tier)];
+    }
+    /**
+     * @brief Writes a readable report of the non-zero counters, one line per operation and tier.
+     *
+     * Size histograms print as "limbs:calls" pairs, where limbs is the lower
+     * bound of the bucket.
+     */
+    void dump(std::ostream &out) const {
+        if (!enabled) {
+            out << "bigint instrumentation disabled (define BIGINT_INSTRUMENTATION=1)\n";
+            return;
+        }
+        out << "operation calls [limbs:calls ...]\n";
+        for (size_t i = 0; i < bigint_detail::OP_COUNT; ++i) {
+            if (calls[i] == 0) {
+                continue;
+            }
+            out << name(static_cast<bigint_op>(i)) << ' ' << calls[i] << " [";
+            const char *separator = "";
+            for (size_t k = 0; k < SIZE_BUCKETS; ++k) {
+                if (sizes[i][k] != 0) {
+                    out << separator << (k == 0 ? 0 : uint64_t{1} << (k - 1)) << ':' << sizes[i][k];
+                    separator = " ";
+                }
+            }
+            out << "]\n";
+        }
+        out << "tier calls ms\n";
+        for (size_t i = 0; i < bigint_detail::TIER_COUNT; ++i) {
+            if (tierCalls[i] != 0) {
+                out << name(static_cast<bigint_tier>(i)) << ' ' << tierCalls[i] << ' '
+                    << static_cast<double>(tierNanos[i]) / 1e6 << '\n';
+            }
+        }
+        out << "allocations " << allocations << " bytes " << bytesAllocated << '\n';
+    }
+};
+
+/**
+ * @brief Routes this thread's bigint allocations to a memory resource for the lifetime of the scope.
+ *
+ * While the scope is active, newly constructed bigints (including every result
+ * and temporary produced by the operators) and the kernels' scratch buffers
+ * allocate from the given resource. Existing bigints keep the resource they
+ * were built with; assigning a result to one copies it into that resource, so
+ * values declared outside the scope remain valid after it ends. Scopes nest.
+ */
+class bigint_resource_scope {
+public:
+    /**
+     * @brief Installs resource for the current thread.
+     * @param resource The resource; it must outlive every bigint allocated from it.
+     */
+    explicit bigint_resource_scope(std::pmr::memory_resource *resource)
+        : previous(bigint_detail::threadResourceSlot()) {
+        bigint_detail::threadResourceSlot() = resource;
+    }
+    ~bigint_resource_scope() {
+        bigint_detail::threadResourceSlot() = previous;
+    }
+    bigint_resource_scope(const bigint_resource_scope &) = delete;
+    bigint_resource_scope &operator=(const bigint_resource_scope &) = delete;
+
+private:
+    std::pmr::memory_resource *previous;
+};
+
+/**
+ * @brief A monotonic arena that serves this thread's bigint allocations until it is destroyed.
+ *
+ * Deallocation is a no-op and all memory is released at once on destruction,
+ * which removes allocator traffic from batch computations. Bigints created
+ * inside the arena must not outlive it; assign results to variables declared
+ * before the arena to keep them.
+ */
+class bigint_arena {
+public:
+    /**
+     * @brief Creates an arena and makes it the current thread's bigint resource.
+     * @param initialBytes Size of the first block requested from the upstream resource.
+     * @param upstream Where the arena obtains its blocks.
+     */
+    explicit bigint_arena(size_t initialBytes = 1 << 16,
+                          std::pmr::memory_resource *upstream = std::pmr::get_default_resource())
+        : buffer(initialBytes, upstream), scope(&buffer) {}
+
+    /**
+     * @brief The underlying resource, e.g. to build bigints that are used on other threads.
+     */
+    std::pmr::memory_resource *resource() { return &buffer; }
+
+private:
+    std::pmr::monotonic_buffer_resource buffer;
+    bigint_resource_scope scope;
+};
+
+template <size_t N>
+class bigint_sum;
+class bigint_product;
+class bigint_batch;
+class bigint_modulus;
+class bigint_view;
+class bigint_parser;
+template <size_t Bits, bool Signed>
+class wide_int;
+
 class bigint {
     /**
-     * @brief Overloaded stream output operator to print bigint objects.
-     * @param out The output stream.
-     * @param num The bigint object to print.
-     * @return A reference to the output stream.
+     * @brief Overloaded stream output operator to print bigint objects.
+     * @param out The output stream.
+     * @param num The bigint object to print.
+     * @return A reference to the output stream.
+     */
+    friend std::ostream &operator<<(std::ostream &out, const bigint &num){
+        if (num.negative) {
+            out << '-';
+        }
+        out << num.toDecimal();
+        return out;
+    }
+private:
+    using limb = bigint_detail::limb;
+
+    /// Magnitude as little-endian base 2^64 limbs, without high zero limbs. Zero is empty.
+    /// Up to two limbs are stored inline, so values below 2^128 never allocate.
+    bigint_detail::limbVector limbs;
+    bool negative;
+     /**
+     * @brief Removes leading zero limbs and clears the sign of zero.
+     */
+    void removeZeros(){
+        while (!limbs.empty() && limbs.back() == 0) {
+            limbs.pop_back();
+        }
+        if (limbs.empty()) {
+            negative = false;
+        }
+    }
+     /**
+     * @brief Validates that a string contains only numeric digits.
+     * @param str The string to validate.
+     * @param startIndex The starting index to check from.
+     * @return True if the string contains only digits, otherwise false.
+     */
+     bool isValidNumber(std::string_view str, size_t startIndex) const {
+        for (size_t i = startIndex; i < str.size(); ++i) {
+            if (str[i] < '0' || str[i] > '9') {
+                return false;
+            }
+        }
+        return true;
+    }
+    /**
+     * @brief Whether the magnitude fits in the inline 128-bit storage.
+     */
+    bool isSmall() const {
+        return limbs.size() <= bigint_detail::limbVector::INLINE_LIMBS;
+    }
+    /**
+     * @brief Returns the magnitude of a small value as an unsigned 128-bit integer.
+     */
+    bigint_detail::dlimb smallMagnitude() const {
+        bigint_detail::dlimb value = 0;
+        if (limbs.size() > 1) {
+            value = static_cast<bigint_detail::dlimb>(limbs[1]) << 64;
+        }
+        if (!limbs.empty()) {
+            value |= limbs[0];
+        }
+        return value;
+    }
+    /**
+     * @brief Sets the magnitude to carry * 2^128 + value; only a carry spills to the heap.
+     */
+    void setSmallMagnitude(bigint_detail::dlimb value, limb carry = 0) {
+        limbs.clear();
+        limbs.push_back(static_cast<limb>(value));
+        limbs.push_back(static_cast<limb>(value >> 64));
+        if (carry != 0) {
+            limbs.push_back(carry);
+        }
+        removeZeros();
+    }
+    /**
+     * @brief Compares the magnitudes of two bigints.
+     * @return -1, 0 or 1 if |a| is less than, equal to or greater than |b|.
+     */
+    static int compareMagnitude(const bigint &a, const bigint &b) {
+        return bigint_detail::compareLimbs(a.limbs.data(), a.limbs.size(),
+                                           b.limbs.data(), b.limbs.size());
+    }
+    /**
+     * @brief Computes a + b or a - b, treating b as having sign bNegative.
+     * @param a The left operand.
+     * @param b The right operand.
+     * @param bNegative The sign to use for b.
+     * @return The signed sum.
+     */
+    static bigint addSigned(const bigint &a, const bigint &b, bool bNegative) {
+        bigint res;
+        if (a.isSmall() && b.isSmall()) {
+            bigint_detail::dlimb x = a.smallMagnitude();
+            bigint_detail::dlimb y = b.smallMagnitude();
+            if (a.negative == bNegative) {
+                bigint_detail::dlimb sum = x + y;
+                res.negative = a.negative;
+                res.setSmallMagnitude(sum, sum < x);
+            } else if (x >= y) {
+                res.negative = a.negative;
+                res.setSmallMagnitude(x - y);
+            } else {
+                res.negative = bNegative;
+                res.setSmallMagnitude(y - x);
+            }
+            return res;
+        }
+        if (a.negative == bNegative) {
+            const bigint &big = a.limbs.size() >= b.limbs.size() ? a : b;
+            const bigint &small = a.limbs.size() >= b.limbs.size() ? b : a;
+            res.limbs.resize(big.limbs.size() + 1);
+            res.limbs[big.limbs.size()] = bigint_detail::addLimbs(
+                res.limbs.data(), big.limbs.data(), big.limbs.size(),
+                small.limbs.data(), small.limbs.size());
+            res.negative = a.negative;
+        } else {
+            int cmp = compareMagnitude(a, b);
+            if (cmp == 0) {
+                return res;
+            }
+            const bigint &big = cmp > 0 ? a : b;
+            const bigint &small = cmp > 0 ? b : a;
+            res.limbs.resize(big.limbs.size());
+            bigint_detail::subLimbs(res.limbs.data(), big.limbs.data(), big.limbs.size(),
+                                    small.limbs.data(), small.limbs.size());
+            res.negative = cmp > 0 ? a.negative : bNegative;
+        }
+        res.removeZeros();
+        return res;
+    }
+    /**
+     * @brief Adds (bNegative ? -b : b) to *this in place, b being a magnitude of bn limbs.
+     *
+     * Touches only the limbs of b plus any carry or borrow run, and grows the
+     * buffer only when the magnitude gets longer. b may be this object's own
+     * limbs (then bn equals the current size) but no other part of them.
+     */
+    void addLimbsInPlace(const limb *b, size_t bn, bool bNegative) {
+        size_t an = limbs.size();
+        if (bn == 0) {
+            return;
+        }
+        if (an == 0) {
+            limbs.assign(b, b + bn);
+            negative = bNegative;
+            return;
+        }
+        if (negative == bNegative) {
+            limb carry;
+            if (an >= bn) {
+                carry = bigint_detail::addLimbs(limbs.data(), limbs.data(), bn, b, bn);
+                for (size_t i = bn; carry != 0 && i < an; ++i) {
+                    carry = ++limbs[i] == 0;
+                }
+            } else {
+                limbs.resize(bn);
+                carry = bigint_detail::addLimbs(limbs.data(), b, bn, limbs.data(), an);
+            }
+            if (carry != 0) {
+                limbs.push_back(carry);
+            }
+            return;
+        }
+        int cmp = bigint_detail::compareLimbs(limbs.data(), an, b, bn);
+        if (cmp == 0) {
+            limbs.clear();
+            negative = false;
+            return;
+        }
+        if (cmp > 0) {
+            limb borrow = bigint_detail::subLimbs(limbs.data(), limbs.data(), bn, b, bn);
+            for (size_t i = bn; borrow != 0 && i < an; ++i) {
+                borrow = limbs[i]-- == 0;
+            }
+        } else {
+            limbs.resize(bn);
+            bigint_detail::subLimbs(limbs.data(), b, bn, limbs.data(), an);
+            negative = bNegative;
+        }
+        removeZeros();
+    }
+    /**
+     * @brief Adds (numNegative ? -|num| : |num|) to *this in place; num may alias *this.
+     */
+    void addInPlace(const bigint &num, bool numNegative) {
+        addLimbsInPlace(num.limbs.data(), num.limbs.size(), numNegative);
+    }
+    /**
+     * @brief Evaluates a signed sum of N terms into dest in a single pass over the limbs.
+     *
+     * Works in two's complement over len + 1 limbs: a subtracted operand V is
+     * added as its complement ~V plus one, so every limb position is a plain
+     * unsigned sum with no sign tests. No intermediate sums are materialized.
+     * dest may be one of the terms; with keepDest its current value is added as
+     * an extra term.
+     * @param dest The destination, whose storage is reused.
+     * @param terms The operands.
+     * @param negate Per operand, whether it is subtracted.
+     * @param keepDest Whether to accumulate onto the current value of dest.
+     */
+    template <size_t N>
+    static void fusedSum(bigint &dest, const std::array<const bigint *, N> &terms,
+                         const std::array<bool, N> &negate, bool keepDest) {
+        using bigint_detail::dlimb;
+        std::array<size_t, N> sizes;
+        std::array<limb, N> masks;
+        std::array<const limb *, N> data;
+        size_t destSize = keepDest ? dest.limbs.size() : 0;
+        limb destMask = keepDest && dest.negative ? ~limb{0} : 0;
+        dlimb acc = destMask & 1;
+        size_t len = destSize;
+        size_t common = keepDest ? destSize : SIZE_MAX;
+        for (size_t i = 0; i < N; ++i) {
+            sizes[i] = terms[i]->limbs.size();
+            masks[i] = terms[i]->negative != negate[i] ? ~limb{0} : 0;
+            acc += masks[i] & 1;
+            len = std::max(len, sizes[i]);
+            common = std::min(common, sizes[i]);
+        }
+        // Resizing may move dest's buffer, so term pointers are taken afterwards.
+        dest.limbs.resize(len + 1);
+        for (size_t i = 0; i < N; ++i) {
+            data[i] = terms[i]->limbs.data();
+        }
+        limb *r = dest.limbs.data();
+        // Two partial sums keep the carry chains short.
+        auto step = [&](size_t j, dlimb even, dlimb odd) {
+            if (keepDest) {
+                odd += (j < destSize ? r[j] : 0) ^ destMask;
+            }
+            acc += even;
+            acc += odd;
+            r[j] = static_cast<limb>(acc);
+            acc >>= 64;
+        };
+        size_t j = 0;
+        for (; j < common; ++j) {
+            dlimb even = 0;
+            dlimb odd = 0;
+            for (size_t i = 0; i + 1 < N; i += 2) {
+                even += data[i][j] ^ masks[i];
+                odd += data[i + 1][j] ^ masks[i + 1];
+            }
+            if (N % 2 == 1) {
+                even += data[N - 1][j] ^ masks[N - 1];
+            }
+            step(j, even, odd);
+        }
+        for (; j <= len; ++j) {
+            dlimb even = 0;
+            for (size_t i = 0; i < N; ++i) {
+                even += (j < sizes[i] ? data[i][j] : 0) ^ masks[i];
+            }
+            step(j, even, 0);
+        }
+        // |sum| < 2^(64 len + 63), so the top bit of the last limb is the sign.
+        dest.negative = (r[len] >> 63) != 0;
+        if (dest.negative) {
+            limb carry = 1;
+            for (size_t k = 0; k <= len; ++k) {
+                r[k] = ~r[k] + carry;
+                carry = carry != 0 && r[k] == 0;
+            }
+        }
+        dest.removeZeros();
+    }
+    /**
+     * @brief Adds a * b (or subtracts it) into *this with one fused kernel.
+     *
+     * Below the Karatsuba threshold every row of the schoolbook product is
+     * multiply-accumulated straight into the destination limbs. Larger or
+     * aliased operands go through the multiplication dispatcher and a
+     * scratch buffer from the current resource instead.
+     */
+    void fusedMulAdd(const bigint &a, const bigint &b, bool subtract) {
+        if (a.limbs.empty() || b.limbs.empty()) {
+            return;
+        }
+        bool productNegative = (a.negative != b.negative) != subtract;
+        const bigint &big = a.limbs.size() >= b.limbs.size() ? a : b;
+        const bigint &small = a.limbs.size() >= b.limbs.size() ? b : a;
+        size_t an = big.limbs.size();
+        size_t bn = small.limbs.size();
+        if (bn >= bigint_tuning::karatsubaThreshold || &a == this || &b == this) {
+            bigint_detail::limbBuffer scratch(an + bn);
+            bigint_detail::mulLimbs(scratch.data(), big.limbs.data(), an, small.limbs.data(), bn);
+            size_t n = an + bn;
+            while (n > 0 && scratch[n - 1] == 0) {
+                --n;
+            }
+            addLimbsInPlace(scratch.data(), n, productNegative);
+            return;
+        }
+        if (limbs.empty()) {
+            negative = productNegative;
+        }
+        size_t len = std::max(limbs.size(), an + bn) + 1;
+        limbs.resize(len);
+        limb *r = limbs.data();
+        const limb *x = big.limbs.data();
+        const limb *y = small.limbs.data();
+        if (negative == productNegative) {
+            for (size_t j = 0; j < bn; ++j) {
+                limb carry = bigint_detail::addMulLimb(r + j, x, an, y[j]);
+                for (size_t i = j + an; carry != 0 && i < len; ++i) {
+                    r[i] += carry;
+                    carry = r[i] < carry;
+                }
+            }
+        } else {
+            bool wrapped = false;
+            for (size_t j = 0; j < bn; ++j) {
+                limb borrow = bigint_detail::subMulLimb(r + j, x, an, y[j]);
+                size_t i = j + an;
+                for (; borrow != 0 && i < len; ++i) {
+                    limb old = r[i];
+                    r[i] = old - borrow;
+                    borrow = old < borrow;
+                }
+                if (borrow != 0) {
+                    wrapped = !wrapped;
+                }
+            }
+            if (wrapped) {
+                // The product exceeded the destination: take the two's complement.
+                limb carry = 1;
+                for (size_t j = 0; j < len; ++j) {
+                    r[j] = ~r[j] + carry;
+                    carry = carry != 0 && r[j] == 0;
+                }
+                negative = !negative;
+            }
+        }
+        removeZeros();
+    }
+    /**
+     * @brief Three-way signed comparison.
+     * @return -1, 0 or 1 if *this is less than, equal to or greater than num.
+     */
+    int compare(const bigint &num) const {
+        bigint_detail::recordOp(bigint_op::compare, std::max(limbs.size(), num.limbs.size()));
+        if (negative != num.negative) {
+            return negative ? -1 : 1;
+        }
+        int cmp;
+        if (isSmall() && num.isSmall()) {
+            bigint_detail::dlimb x = smallMagnitude();
+            bigint_detail::dlimb y = num.smallMagnitude();
+            cmp = x < y ? -1 : (x > y ? 1 : 0);
+        } else {
+            cmp = compareMagnitude(*this, num);
+        }
+        return negative ? -cmp : cmp;
+    }
+    /**
+     * @brief Returns the magnitude of a 64-bit integer, including INT64_MIN.
+     */
+    static limb wordMagnitude(int64_t value) {
+        limb magnitude = static_cast<limb>(value);
+        return value < 0 ? 0 - magnitude : magnitude;
+    }
+    /**
+     * @brief Adds (vNegative ? -v : v) in place, only propagating the carry or borrow.
+     */
+    void addWordInPlace(limb v, bool vNegative) {
+        if (v == 0) {
+            return;
+        }
+        if (limbs.empty()) {
+            limbs.push_back(v);
+            negative = vNegative;
+            return;
+        }
+        limb *p = limbs.data();
+        size_t n = limbs.size();
+        if (negative == vNegative) {
+            p[0] += v;
+            if (p[0] < v) {
+                size_t i = 1;
+                while (i < n && ++p[i] == 0) {
+                    ++i;
+                }
+                if (i == n) {
+                    limbs.push_back(1);
+                }
+            }
+            return;
+        }
+        if (n == 1 && p[0] < v) {
+            p[0] = v - p[0];
+            negative = vNegative;
+            return;
+        }
+        limb old = p[0];
+        p[0] = old - v;
+        if (old < v) {
+            // |*this| > v, so a higher limb absorbs the borrow.
+            size_t i = 1;
+            while (p[i]-- == 0) {
+                ++i;
+            }
+        }
+        removeZeros();
+    }
+    /**
+     * @brief Multiplies by (vNegative ? -v : v) in place with a single-limb kernel.
+     */
+    void mulWordInPlace(limb v, bool vNegative) {
+        if (v == 0 || limbs.empty()) {
+            limbs.clear();
+            negative = false;
+            return;
+        }
+        limb carry = bigint_detail::mulLimb(limbs.data(), limbs.data(), limbs.size(), v);
+        if (carry != 0) {
+            limbs.push_back(carry);
+        }
+        negative = negative != vNegative;
+    }
+    /**
+     * @brief Divides by (dNegative ? -d : d) in place, truncating towards zero.
+     * @return The magnitude of the remainder, whose sign is the dividend's.
+     * @throws std::domain_error if d is zero.
+     */
+    limb divWordInPlace(limb d, bool dNegative) {
+        if (d == 0) {
+            throw std::domain_error("Division by zero");
+        }
+        limb rem = bigint_detail::divLimb(limbs.data(), limbs.data(), limbs.size(), d);
+        negative = negative != dNegative;
+        removeZeros();
+        return rem;
+    }
+    /**
+     * @brief Three-way signed comparison with a 64-bit integer.
+     * @return -1, 0 or 1 if *this is less than, equal to or greater than num.
+     */
+    int compare(int64_t num) const {
+        bigint_detail::recordOp(bigint_op::compare, limbs.size());
+        bool numNegative = num < 0;
+        if (negative != numNegative) {
+            return negative ? -1 : 1;
+        }
+        limb magnitude = wordMagnitude(num);
+        int cmp;
+        if (limbs.size() > 1) {
+            cmp = 1;
+        } else {
+            limb own = limbs.empty() ? 0 : limbs[0];
+            cmp = own < magnitude ? -1 : (own > magnitude ? 1 : 0);
+        }
+        return negative ? -cmp : cmp;
+    }
+    /**
+     * @brief Moves the magnitude by whole limbs: up multiplies by 2^(64 k), down divides and truncates.
+     * @param num The value to shift.
+     * @param k The number of limbs.
+     * @param up True to shift towards the high end.
+     * @return The shifted value, keeping the sign of num.
+     */
+    static bigint shiftLimbs(const bigint &num, size_t k, bool up) {
+        bigint res;
+        if (up) {
+            if (!num.limbs.empty()) {
+                res.limbs.assign(k, 0);
+                res.limbs.insert(res.limbs.end(), num.limbs.begin(), num.limbs.end());
+            }
+        } else if (k < num.limbs.size()) {
+            res.limbs.assign(num.limbs.begin() + static_cast<std::ptrdiff_t>(k), num.limbs.end());
+        }
+        res.negative = num.negative && !res.limbs.empty();
+        return res;
+    }
+    /**
+     * @brief Returns 2^(64 k).
+     */
+    static bigint powerOfBase(size_t k) {
+        bigint res;
+        res.limbs.assign(k + 1, 0);
+        res.limbs[k] = 1;
+        return res;
+    }
+    /**
+     * @brief Moves the magnitude by bits: up multiplies by 2^bits, down divides and truncates.
+     * @return The shifted value, keeping the sign of num.
+     */
+    static bigint shiftBits(const bigint &num, size_t bits, bool up) {
+        bigint res = shiftLimbs(num, bits / 64, up);
+        unsigned rest = static_cast<unsigned>(bits % 64);
+        if (rest != 0 && !res.limbs.empty()) {
+            if (up) {
+                limb carry = bigint_detail::shlLimbs(res.limbs.data(), res.limbs.data(), res.limbs.size(), rest);
+                if (carry != 0) {
+                    res.limbs.push_back(carry);
+                }
+            } else {
+                bigint_detail::shrLimbs(res.limbs.data(), res.limbs.data(), res.limbs.size(), rest);
+                res.removeZeros();
+            }
+        }
+        return res;
+    }
+    /**
+     * @brief Number of significant bits of the magnitude; 0 for zero.
+     */
+    size_t bitLength() const {
+        if (limbs.empty()) {
+            return 0;
+        }
+        return limbs.size() * 64 - static_cast<size_t>(std::countl_zero(limbs.back()));
+    }
+    /**
+     * @brief Returns num * num without counting a public operation.
+     */
+    static bigint squareOf(const bigint &num) {
+        size_t n = num.limbs.size();
+        bigint res;
+        if (n == 0) {
+            return res;
+        }
+        if (n == 1) {
+            res.setSmallMagnitude(static_cast<bigint_detail::dlimb>(num.limbs[0]) * num.limbs[0]);
+            return res;
+        }
+        res.limbs.resize(2 * n);
+        bigint_detail::sqrLimbs(res.limbs.data(), num.limbs.data(), n);
+        res.removeZeros();
+        return res;
+    }
+    /**
+     * @brief Returns 64 bits of the magnitude starting at bit shift (zeros past the top).
+     */
+    limb bitsAt(size_t shift) const {
+        size_t i = shift / 64;
+        unsigned offset = static_cast<unsigned>(shift % 64);
+        limb lo = i < limbs.size() ? limbs[i] : 0;
+        limb hi = i + 1 < limbs.size() ? limbs[i + 1] : 0;
+        return offset == 0 ? lo : (lo >> offset) | (hi << (64 - offset));
+    }
+    struct gcdMatrix;
+    static bool lehmerCofactors(const bigint &x, const bigint &y, int64_t cofactors[4]);
+    static bool gcdStep(bigint &a, bigint &b, size_t s, gcdMatrix *m);
+    static void applyInverse(bigint &a, bigint &b, gcdMatrix &m);
+    static bool hgcd(bigint &a, bigint &b, gcdMatrix &m);
+    static void gcdReduce(bigint &a, bigint &b, gcdMatrix *m);
+    static bool hasSmallFactor(const bigint &n, uint64_t limit);
+    static bool millerRabin(const bigint &n, bigint_modulus &mod, const bigint &base);
+    static bool strongLucas(const bigint &n, bigint_modulus &mod);
+    /**
+     * @brief Multiplies values[0 .. n) by a balanced product tree.
+     *
+     * Both halves have about the same size, so large products reach the fast
+     * multiplication tiers; large subtrees run in parallel when
+     * bigint_tuning::threads allows it.
+     */
+    static bigint productTree(const bigint *const *values, size_t n) {
+        if (n == 0) {
+            return bigint(1);
+        }
+        if (n == 1) {
+            return *values[0];
+        }
+        if (n == 2) {
+            return *values[0] * *values[1];
+        }
+        size_t half = n / 2;
+        bigint left, right;
+        bigint_detail::forkJoin(bigint_detail::parallelPool(n * values[half]->limbs.size()),
+                                [&] { left = productTree(values, half); },
+                                [&] { right = productTree(values + half, n - half); });
+        return left * right;
+    }
+    /**
+     * @brief Multiplies machine words, packing them into full limbs before building the tree.
+     */
+    static bigint productOfWords(const std::vector<limb> &words) {
+        std::vector<bigint> leaves;
+        limb packed = 1;
+        for (limb w : words) {
+            bigint_detail::dlimb p = static_cast<bigint_detail::dlimb>(packed) * w;
+            if (p >> 64 != 0) {
+                leaves.emplace_back();
+                leaves.back().limbs.push_back(packed);
+                packed = w;
+            } else {
+                packed = static_cast<limb>(p);
+            }
+        }
+        if (packed == 0) {
+            return bigint();
+        }
+        leaves.emplace_back();
+        leaves.back().limbs.push_back(packed);
+        std::vector<const bigint *> pointers;
+        for (const bigint &leaf : leaves) {
+            pointers.push_back(&leaf);
+        }
+        return productTree(pointers.data(), pointers.size());
+    }
+    /**
+     * @brief Odd part of n!, from odd(n!) = odd((n/2)!)^2 * odd(swing(n)) (Luschny's prime swing).
+     *
+     * swing(n) = n! / (n/2)!^2 holds the prime p with exponent
+     * sum of (floor(n / p^i) mod 2), which needs no big arithmetic.
+     * @param primes All primes up to at least n.
+     */
+    static bigint oddFactorial(uint64_t n, const std::vector<uint64_t> &primes) {
+        if (n < 3) {
+            return bigint(1);
+        }
+        bigint half = oddFactorial(n / 2, primes);
+        std::vector<limb> factors;
+        for (size_t i = 1; i < primes.size() && primes[i] <= n; ++i) {
+            uint64_t p = primes[i];
+            for (uint64_t q = n / p; q > 0; q /= p) {
+                if (q & 1) {
+                    factors.push_back(p);
+                }
+            }
+        }
+        bigint swing = productOfWords(factors);
+        return half * half * swing;
+    }
+    /**
+     * @brief One integer Newton step towards the k-th root of x: ((k - 1) y + x / y^(k - 1)) / k.
+     *
+     * For any positive y the result is at least floor(x^(1/k)).
+     */
+    static bigint rootStep(const bigint &x, const bigint &y, uint64_t k) {
+        if (k == 2) {
+            return shiftBits(y + x / y, 1, false);
+        }
+        int64_t km1 = static_cast<int64_t>(k - 1);
+        return (y * km1 + x / pow(y, k - 1)) / static_cast<int64_t>(k);
+    }
+    /**
+     * @brief floor(x^(1/k)) for positive x and k >= 2.
+     *
+     * The root of x >> (k m), where m is a bit under half the root's size,
+     * is computed recursively and shifted back; it is within 2^m of the
+     * answer, so one Newton step at full precision leaves an error below one
+     * and a final check fixes it. The cost is dominated by the last step, a
+     * few multiplications and one division of x's size.
+     */
+    static bigint rootFloor(const bigint &x, uint64_t k) {
+        size_t bits = x.bitLength();
+        if (k >= bits) {
+            return bigint(1);
+        }
+        size_t rootBits = (bits + k - 1) / k;
+        bigint y;
+        if (rootBits <= 64) {
+            // Newton from 2^rootBits, which is above the root, decreases monotonically until it stops at the floor.
+            y = shiftBits(bigint(1), rootBits, true);
+            for (;;) {
+                bigint next = rootStep(x, y, k);
+                if (next >= y) {
+                    return y;
+                }
+                y = std::move(next);
+            }
+        }
+        size_t m = (rootBits - static_cast<size_t>(std::bit_width(k)) - 2) / 2;
+        y = shiftBits(rootFloor(shiftBits(x, k * m, false), k), m, true);
+        y = rootStep(x, y, k);
+        while (pow(y, k) > x) {
+            --y;
+        }
+        while (pow(y + 1, k) <= x) {
+            ++y;
+        }
+        return y;
+    }
+    /**
+     * @brief Divides magnitudes with Knuth Algorithm D (or the single-limb path).
+     * @return The pair (|a| / |b|, |a| % |b|), both non-negative.
+     */
+    static std::pair<bigint, bigint> divmodBasecase(const bigint &a, const bigint &b) {
+        bigint_detail::tierTimer timer(bigint_tier::divBasecase);
+        std::pair<bigint, bigint> res;
+        size_t an = a.limbs.size();
+        size_t bn = b.limbs.size();
+        if (an < bn) {
+            res.second = a;
+            res.second.negative = false;
+            return res;
+        }
+        res.first.limbs.resize(an - bn + 1);
+        if (bn == 1) {
+            limb rem = bigint_detail::divLimb(res.first.limbs.data(), a.limbs.data(), an, b.limbs[0]);
+            if (rem != 0) {
+                res.second.limbs.push_back(rem);
+            }
+        } else {
+            res.second.limbs.resize(bn);
+            bigint_detail::divremBasecase(res.first.limbs.data(), res.second.limbs.data(),
+                                          a.limbs.data(), an, b.limbs.data(), bn);
+        }
+        res.first.removeZeros();
+        res.second.removeZeros();
+        return res;
+    }
+    /**
+     * @brief Computes floor(2^(128 n) / b) for a positive n-limb b by Newton iteration.
+     *
+     * The top half of b gives a half-precision reciprocal recursively; one Newton
+     * step x + x (2^(128 n) - b x) / 2^(128 n) doubles its precision, and a short
+     * correction loop makes the result exact so errors never accumulate.
+     */
+    static bigint reciprocal(const bigint &b) {
+        size_t n = b.limbs.size();
+        bigint one = powerOfBase(2 * n);
+        if (n < std::max<size_t>(bigint_tuning::newtonThreshold, 8)) {
+            return divmodBasecase(one, b).first;
+        }
+        bigint_detail::tierTimer timer(bigint_tier::reciprocal);
+        // h limbs of b give about 64 (h - 1) correct bits, which one Newton step
+        // doubles to at least 64 (n + 2): enough for the n + 1 limbs of the result.
+        size_t h = n / 2 + 2;
+        bigint x = shiftLimbs(reciprocal(shiftLimbs(b, n - h, false)), n - h, true);
+        bigint e = one - b * x;
+        x = x + shiftLimbs(x * e, 2 * n, false);
+        bigint r = one - b * x;
+        while (r.negative) {
+            x = x - 1;
+            r = r + b;
+        }
+        while (compareMagnitude(r, b) >= 0) {
+            x = x + 1;
+            r = r - b;
+        }
+        return x;
+    }
+    /**
+     * @brief Divides magnitudes using a Newton reciprocal of the divisor.
+     *
+     * The dividend is consumed in blocks of n limbs (n = size of b); each block
+     * quotient comes from one multiplication by the reciprocal and is fixed up
+     * by at most a few subtractions.
+     * @param a The dividend.
+     * @param divisor The positive divisor.
+     * @param inverse reciprocal(divisor), which callers may cache.
+     * @return The pair (|a| / divisor, |a| % divisor), both non-negative.
+     */
+    static std::pair<bigint, bigint> divmodNewton(const bigint &a, const bigint &divisor, const bigint &inverse) {
+        bigint_detail::tierTimer timer(bigint_tier::divNewton);
+        size_t n = divisor.limbs.size();
+        size_t blocks = (a.limbs.size() + n - 1) / n;
+        std::pair<bigint, bigint> res;
+        res.first.limbs.assign(blocks * n, 0);
+        bigint &rem = res.second;
+        for (size_t i = blocks; i-- > 0;) {
+            size_t lo = i * n;
+            size_t hi = std::min(lo + n, a.limbs.size());
+            bigint x;
+            x.limbs.assign(a.limbs.begin() + static_cast<std::ptrdiff_t>(lo),
+                           a.limbs.begin() + static_cast<std::ptrdiff_t>(hi));
+            x.removeZeros();
+            x = x + shiftLimbs(rem, n, true);
+            bigint q = shiftLimbs(x * inverse, 2 * n, false);
+            rem = x - q * divisor;
+            while (compareMagnitude(rem, divisor) >= 0) {
+                q = q + 1;
+                rem = rem - divisor;
+            }
+            std::copy(q.limbs.begin(), q.limbs.end(),
+                      res.first.limbs.begin() + static_cast<std::ptrdiff_t>(lo));
+        }
+        res.first.removeZeros();
+        return res;
+    }
+    /**
+     * @brief Truncating signed division, picking the algorithm by operand size.
+     * @return The pair (a / b, a % b) with the quotient rounded towards zero.
+     */
+    static std::pair<bigint, bigint> divideSigned(const bigint &a, const bigint &b) {
+        if (b.limbs.empty()) {
+            throw std::domain_error("Division by zero");
+        }
+        size_t threshold = std::max<size_t>(bigint_tuning::newtonThreshold, 8);
+        bool newton = b.limbs.size() >= threshold && a.limbs.size() >= b.limbs.size() + threshold;
+        std::pair<bigint, bigint> res;
+        if (newton) {
+            bigint divisor = b;
+            divisor.negative = false;
+            res = divmodNewton(a, divisor, reciprocal(divisor));
+        } else {
+            res = divmodBasecase(a, b);
+        }
+        res.first.negative = a.negative != b.negative && !res.first.limbs.empty();
+        res.second.negative = a.negative && !res.second.limbs.empty();
+        return res;
+    }
+    /**
+     * @brief Returns the power tree node for 10^(19 * 2^k), cached per thread.
+     *
+     * Each node holds the power and, once a Newton division has needed it, its
+     * reciprocal. The nodes are shared by decimal parsing and printing; a deque
+     * keeps earlier references valid while the cache grows. The cache outlives
+     * any bigint_arena, so its entries always use the process default resource.
+     */
+    static std::pair<bigint, bigint> &decimalPowerNode(size_t k) {
+        static thread_local std::deque<std::pair<bigint, bigint>> powers;
+        std::pmr::memory_resource *resource = std::pmr::get_default_resource();
+        if (powers.empty()) {
+            bigint base(0, resource);
+            base.limbs.push_back(bigint_detail::DECIMAL_BASE);
+            powers.emplace_back(std::move(base), bigint(0, resource));
+        }
+        while (powers.size() <= k) {
+            powers.emplace_back(bigint(powers.back().first * powers.back().first, resource), bigint(0, resource));
+        }
+        return powers[k];
+    }
+    /**
+     * @brief Returns 10^(19 * 2^k) from the per-thread power tree.
+     */
+    static const bigint &decimalPower(size_t k) {
+        return decimalPowerNode(k).first;
+    }
+    /**
+     * @brief Divides a non-negative value by 10^(19 * 2^k), reusing the cached reciprocal for large powers.
+     */
+    static std::pair<bigint, bigint> divideByDecimalPower(const bigint &value, size_t k) {
+        std::pair<bigint, bigint> &node = decimalPowerNode(k);
+        if (node.first.limbs.size() < std::max<size_t>(bigint_tuning::newtonThreshold, 8)) {
+            return divmodBasecase(value, node.first);
+        }
+        if (node.second.limbs.empty()) {
+            node.second = reciprocal(node.first);
+        }
+        return divmodNewton(value, node.first, node.second);
+    }
+    /**
+     * @brief Appends the digits of a non-negative value using repeated division by 10^19.
+     * @param out The string to append to.
+     * @param value The value to print.
+     * @param width The exact number of digits to write (zero-padded) if pad is set.
+     * @param pad Whether to pad to width.
+     */
+    static void writeDecimalBasecase(std::string &out, const bigint &value, size_t width, bool pad) {
+        bigint_detail::tierTimer timer(bigint_tier::printBasecase);
+        bigint_detail::limbBuffer quotient(value.limbs.begin(), value.limbs.end());
+        bigint_detail::limbBuffer chunks;
+        size_t n = quotient.size();
+        while (n > 0) {
+            chunks.push_back(bigint_detail::divLimb(quotient.data(), quotient.data(), n,
+                                                    bigint_detail::DECIMAL_BASE));
+            while (n > 0 && quotient[n - 1] == 0) {
+                --n;
+            }
+        }
+        if (chunks.empty()) {
+            out.append(pad ? width : 1, '0');
+            return;
+        }
+        std::string top = std::to_string(chunks.back());
+        if (pad) {
+            out.append(width - top.size() - (chunks.size() - 1) * bigint_detail::DIGITS_PER_LIMB, '0');
+        }
+        out += top;
+        for (size_t i = chunks.size(); i > 1; --i) {
+            char buffer[bigint_detail::DIGITS_PER_LIMB];
+            limb chunk = chunks[i - 2];
+            for (size_t d = bigint_detail::DIGITS_PER_LIMB; d > 0; --d) {
+                buffer[d - 1] = static_cast<char>('0' + chunk % 10);
+                chunk /= 10;
+            }
+            out.append(buffer, bigint_detail::DIGITS_PER_LIMB);
+        }
+    }
+    /**
+     * @brief Appends the digits of a non-negative value by divide and conquer.
+     *
+     * Splits value by the cached power 10^(19 * 2^k) whose size is about half of
+     * value, so conversion costs O(M(n) log n) with fast division. Reciprocals of
+     * the large powers are cached too, so repeated printing skips the Newton setup.
+     */
+    static void writeDecimal(std::string &out, const bigint &value, size_t width, bool pad) {
+        if (pad && width == 0) {
+            return;
+        }
+        if (value.limbs.size() < std::max<size_t>(bigint_tuning::decimalThreshold, 2)) {
+            writeDecimalBasecase(out, value, width, pad);
+            return;
+        }
+        size_t k = 0;
+        while (decimalPower(k + 1).limbs.size() <= (value.limbs.size() + 1) / 2) {
+            ++k;
+        }
+        size_t lowDigits = bigint_detail::DIGITS_PER_LIMB << k;
+        std::pair<bigint, bigint> parts = divideByDecimalPower(value, k);
+        if (!pad && parts.first.limbs.empty()) {
+            writeDecimal(out, parts.second, 0, false);
+            return;
+        }
+        writeDecimal(out, parts.first, pad ? width - lowDigits : 0, pad);
+        writeDecimal(out, parts.second, lowDigits, true);
+    }
+    /**
+     * @brief Converts the magnitude to its decimal digits.
+     * @return The decimal representation without a sign.
+     */
+    std::string toDecimal() const {
+        bigint_detail::recordOp(bigint_op::print, limbs.size());
+        std::string res;
+        res.reserve(limbs.size() * 20 + 1);
+        writeDecimal(res, *this, 0, false);
+        return res;
+    }
+    /**
+     * @brief Parses validated decimal digits by folding in 19-digit chunks (quadratic).
+     */
+    static bigint parseDecimalBasecase(const char *digits, size_t len) {
+        bigint_detail::tierTimer timer(bigint_tier::parseBasecase);
+        bigint res;
+        res.limbs.reserve(len / bigint_detail::DIGITS_PER_LIMB + 1);
+        size_t chunk = len % bigint_detail::DIGITS_PER_LIMB;
+        if (chunk == 0) {
+            chunk = bigint_detail::DIGITS_PER_LIMB;
+        }
+        for (size_t pos = 0; pos < len; pos += chunk, chunk = bigint_detail::DIGITS_PER_LIMB) {
+            limb value = 0;
+            limb scale = 1;
+            for (size_t i = pos; i < pos + chunk; ++i) {
+                value = value * 10 + static_cast<limb>(digits[i] - '0');
+                scale *= 10;
+            }
+            limb carry = bigint_detail::mulLimb(res.limbs.data(), res.limbs.data(), res.limbs.size(), scale);
+            for (size_t i = 0; i < res.limbs.size() && value != 0; ++i) {
+                res.limbs[i] += value;
+                value = res.limbs[i] < value;
+            }
+            carry += value;
+            if (carry != 0) {
+                res.limbs.push_back(carry);
+            }
+        }
+        res.removeZeros();
+        return res;
+    }
+    /**
+     * @brief Parses validated decimal digits by divide and conquer.
+     *
+     * The low 19 * 2^k digits (about half) are parsed separately and the high
+     * part is scaled by the cached power 10^(19 * 2^k).
+     */
+    static bigint parseDecimal(const char *digits, size_t len) {
+        if (len < std::max<size_t>(bigint_tuning::decimalThreshold, 2) * bigint_detail::DIGITS_PER_LIMB) {
+            return parseDecimalBasecase(digits, len);
+        }
+        size_t k = 0;
+        while ((bigint_detail::DIGITS_PER_LIMB << (k + 1)) < len) {
+            ++k;
+        }
+        size_t lowDigits = bigint_detail::DIGITS_PER_LIMB << k;
+        bigint high = parseDecimal(digits, len - lowDigits);
+        return high * decimalPower(k) + parseDecimal(digits + (len - lowDigits), lowDigits);
+    }
+
+public:
+    /**
+     * @brief Default constructor.
+     */
+    bigint(): negative(false) {}
+    /**
+     * @brief Copy constructor that allocates from the given memory resource.
+     * @param num The bigint to copy.
+     * @param resource The resource; it must outlive this bigint.
+     */
+    bigint(const bigint &num, std::pmr::memory_resource *resource): limbs(num.limbs, resource), negative(num.negative) {}
+    /**
+     * @brief Returns the memory resource this bigint allocates its limbs from.
+     */
+    std::pmr::memory_resource *resource() const {
+        return limbs.memoryResource();
+    }
+     /**
+     * @brief Constructor that takes 64-bit integer.
+     * @param num The integer to initialize the bigint.
+     */
+    bigint(const int64_t num): negative(num < 0) {
+        limb magnitude = static_cast<limb>(num);
+        if (negative) {
+            magnitude = 0 - magnitude;
+        }
+        if (magnitude != 0) {
+            limbs.push_back(magnitude);
+        }
+    }
+    /**
+     * @brief Constructor that takes a 64-bit integer and the memory resource to allocate limbs from.
+     * @param num The integer to initialize the bigint.
+     * @param resource The resource; it must outlive this bigint.
+     */
+    bigint(const int64_t num, std::pmr::memory_resource *resource): limbs(resource), negative(false) {
+        *this = bigint(num);
+    }
+     /**
+     * @brief Constructor that takes a string.
+     * @param num A string representing a number.
+     */
+    bigint(const std::string &num) : bigint(std::string_view(num)) {}
+    /**
+     * @brief Constructor that takes a C string, parsed in place without building a std::string.
+     * @param num A null-terminated string representing a number.
+     */
+    template <class Char>
+        requires std::is_same_v<Char, char>
+    bigint(const Char *num) : bigint(std::string_view(num)) {}
+    /**
+     * @brief Constructor that parses the characters of a string view in place.
+     * @param num A decimal number with an optional leading '-'.
+     * @throws std::invalid_argument if num is empty or not a number.
+     */
+    bigint(std::string_view num) {
+        if (num.empty()) {
+            throw std::invalid_argument("Empty string cannot be converted");
+        }
+
+        size_t startIndex = 0;
+        if (num[0] == '-') {
+            negative = true;
+            startIndex = 1;
+        } else {
+            negative = false;
+        }
+
+        if (startIndex == num.size() || !isValidNumber(num, startIndex)) {
+            throw std::invalid_argument("Invalid characters");
+        }
+
+        while (startIndex + 1 < num.size() && num[startIndex] == '0') {
+            ++startIndex;
+        }
+        bigint_detail::recordOp(bigint_op::parse, (num.size() - startIndex) / bigint_detail::DIGITS_PER_LIMB + 1);
+        bool sign = negative;
+        *this = parseDecimal(num.data() + startIndex, num.size() - startIndex);
+        negative = sign && !limbs.empty();
+    }
+    /**
+     * @brief Overloaded addition operator.
+     * @param num The bigint to add.
+     * @return A new bigint.
+     */
+    bigint operator+(const bigint &num) const &{
+        bigint_detail::recordOp(bigint_op::add, std::max(limbs.size(), num.limbs.size()));
+        return addSigned(*this, num, num.negative);
+    }
+    /**
+     * @brief Addition that reuses the storage of a temporary operand.
+     *
+     * The in-place path only grows the buffer when the sum gets longer, so a
+     * chain like a + b + c + d allocates once, for a + b.
+     * @param num The bigint to add.
+     * @return The sum, in the temporary's storage.
+     */
+    bigint operator+(const bigint &num) &&{
+        *this += num;
+        return std::move(*this);
+    }
+    bigint operator+(bigint &&num) const &{
+        num += *this;
+        return std::move(num);
+    }
+    bigint operator+(bigint &&num) &&{
+        *this += num;
+        return std::move(*this);
+    }
+      /**
+     * @brief Overloaded addition assignment operator.
+     * @param num The bigint to add.
+     * @return A reference to the current bigint.
+     */
+    bigint& operator+=(const bigint &num){
+        bigint_detail::recordOp(bigint_op::add, std::max(limbs.size(), num.limbs.size()));
+        addInPlace(num, num.negative);
+        return *this;
+    }
+    /**
+     * @brief Overloaded subtraction operator.
+     * @param num The bigint to subtract.
+     * @return A new bigint.
+     */
+    bigint operator-(const bigint &num) const &{
+        bigint_detail::recordOp(bigint_op::sub, std::max(limbs.size(), num.limbs.size()));
+        return addSigned(*this, num, !num.negative && !num.limbs.empty());
+    }
+    /**
+     * @brief Subtraction that reuses the storage of a temporary operand.
+     * @param num The bigint to subtract.
+     * @return The difference, in the temporary's storage.
+     */
+    bigint operator-(const bigint &num) &&{
+        *this -= num;
+        return std::move(*this);
+    }
+    bigint operator-(bigint &&num) const &{
+        // a - t is computed as (-t) + a in the storage of t.
+        bigint_detail::recordOp(bigint_op::sub, std::max(limbs.size(), num.limbs.size()));
+        num.negative = !num.negative && !num.limbs.empty();
+        num.addInPlace(*this, negative);
+        return std::move(num);
+    }
+    bigint operator-(bigint &&num) &&{
+        *this -= num;
+        return std::move(*this);
+    }
+     /**
+     * @brief Overloaded subtraction assignment operator.
+     * @param num The bigint to subtract.
+     * @return A reference to the current bigint after subtraction.
+     */
+    bigint &operator-=(const bigint &num){
+        bigint_detail::recordOp(bigint_op::sub, std::max(limbs.size(), num.limbs.size()));
+        addInPlace(num, !num.negative && !num.limbs.empty());
+        return *this;
+    }
+     /**
+     * @brief Overloaded multiplication operator.
+     * @param num The bigint to multiply with.
+     * @return A new bigint.
+     */
+    bigint operator*(const bigint &num) &&{
+        *this *= num;
+        return std::move(*this);
+    }
+    bigint operator*(bigint &&num) const &{
+        num *= *this;
+        return std::move(num);
+    }
+    bigint operator*(bigint &&num) &&{
+        *this *= num;
+        return std::move(*this);
+    }
+    bigint operator*(const bigint &num) const &{
+        bigint_detail::recordOp(bigint_op::mul, std::max(limbs.size(), num.limbs.size()));
+        bigint resultMul;
+        if (limbs.empty() || num.limbs.empty()) {
+            return resultMul;
+        }
+        resultMul.negative = negative != num.negative;
+        if (limbs.size() == 1 && num.limbs.size() == 1) {
+            resultMul.setSmallMagnitude(static_cast<bigint_detail::dlimb>(limbs[0]) * num.limbs[0]);
+            return resultMul;
+        }
+        const bigint &big = limbs.size() >= num.limbs.size() ? *this : num;
+        const bigint &small = limbs.size() >= num.limbs.size() ? num : *this;
+        if (limbs.size() + num.limbs.size() <= 2 * bigint_detail::limbVector::INLINE_LIMBS) {
+            // Multiply on the stack so products that still fit in 128 bits stay inline.
+            limb product[2 * bigint_detail::limbVector::INLINE_LIMBS];
+            size_t n = limbs.size() + num.limbs.size();
+            bigint_detail::mulBasecase(product, big.limbs.data(), big.limbs.size(),
+                                       small.limbs.data(), small.limbs.size());
+            while (n > 0 && product[n - 1] == 0) {
+                --n;
+            }
+            resultMul.limbs.assign(product, product + n);
+            return resultMul;
+        }
+        resultMul.limbs.resize(limbs.size() + num.limbs.size());
+        bigint_detail::mulLimbs(resultMul.limbs.data(), big.limbs.data(), big.limbs.size(),
+                                small.limbs.data(), small.limbs.size());
+        resultMul.removeZeros();
+        return resultMul;
+    }
+    /**
+     * @brief Overloaded multiplication assignment operator.
+     * @param num The bigint to multiply with.
+     * @return A reference to the current bigint after multiplication.
+     */
+    bigint &operator*=(const bigint &num){
+        bigint_detail::recordOp(bigint_op::mul, std::max(limbs.size(), num.limbs.size()));
+        if (limbs.empty() || num.limbs.empty()) {
+            limbs.clear();
+            negative = false;
+            return *this;
+        }
+        bool sign = negative != num.negative;
+        size_t an = limbs.size();
+        size_t bn = num.limbs.size();
+        if (an == 1 || bn == 1) {
+            // A single-limb factor scales the other operand in place.
+            limb factor = bn == 1 ? num.limbs[0] : limbs[0];
+            if (bn != 1) {
+                limbs = num.limbs;
+            }
+            limb carry = bigint_detail::mulLimb(limbs.data(), limbs.data(), limbs.size(), factor);
+            if (carry != 0) {
+                limbs.push_back(carry);
+            }
+        } else {
+            // The product cannot overlap its operands, so it goes through a
+            // scratch buffer and is copied back into the existing storage.
+            bigint_detail::limbBuffer scratch(an + bn);
+            bigint_detail::mulLimbs(scratch.data(), limbs.data(), an, num.limbs.data(), bn);
+            size_t n = an + bn;
+            while (n > 0 && scratch[n - 1] == 0) {
+                --n;
+            }
+            limbs.assign(scratch.data(), scratch.data() + n);
+        }
+        negative = sign;
+        removeZeros();
+        return *this;
+    }
+    /**
+     * @brief Overloaded division operator, rounding towards zero.
+     * @param num The divisor.
+     * @return A new bigint.
+     * @throws std::domain_error if num is zero.
+     */
+    bigint operator/(const bigint &num) const{
+        bigint_detail::recordOp(bigint_op::div, limbs.size());
+        return divideSigned(*this, num).first;
+    }
+    /**
+     * @brief Overloaded division assignment operator.
+     * @param num The divisor.
+     * @return A reference to the current bigint after division.
+     */
+    bigint &operator/=(const bigint &num){
+        *this = *this / num;
+        return *this;
+    }
+    /**
+     * @brief Overloaded modulo operator; the result has the sign of the dividend.
+     * @param num The divisor.
+     * @return A new bigint.
+     * @throws std::domain_error if num is zero.
+     */
+    bigint operator%(const bigint &num) const{
+        bigint_detail::recordOp(bigint_op::mod, limbs.size());
+        return divideSigned(*this, num).second;
+    }
+    /**
+     * @brief Overloaded modulo assignment operator.
+     * @param num The divisor.
+     * @return A reference to the current bigint after the modulo.
+     */
+    bigint &operator%=(const bigint &num){
+        *this = *this % num;
+        return *this;
+    }
+    /**
+     * @brief Computes quotient and remainder in one pass.
+     * @param a The dividend.
+     * @param b The divisor.
+     * @return The pair (a / b, a % b), matching operator/ and operator%.
+     * @throws std::domain_error if b is zero.
+     */
+    friend std::pair<bigint, bigint> divmod(const bigint &a, const bigint &b){
+        bigint_detail::recordOp(bigint_op::div, a.limbs.size());
+        return divideSigned(a, b);
+    }
+    /**
+     * @brief Returns num * num through the squaring kernels.
+     *
+     * Same as num * num (which detects the aliasing too), but also squares
+     * expressions without naming them twice, e.g. square(a + b).
+     */
+    friend bigint square(const bigint &num){
+        bigint_detail::recordOp(bigint_op::mul, num.limbs.size());
+        return squareOf(num);
+    }
+    /**
+     * @brief Raises base to a power by left-to-right square-and-multiply.
+     *
+     * Powers of two are built directly as a shifted one.
+     * @param base The base.
+     * @param exponent The exponent; pow(x, 0) is 1, also for x = 0.
+     * @return base^exponent.
+     * @throws std::length_error if the result cannot be stored.
+     */
+    friend bigint pow(const bigint &base, uint64_t exponent){
+        if (exponent == 0) {
+            return bigint(1);
+        }
+        if (base.limbs.empty()) {
+            return bigint();
+        }
+        bool sign = base.negative && (exponent & 1) != 0;
+        size_t bits = base.bitLength();
+        if (bits > 1 && exponent > static_cast<uint64_t>(UINT32_MAX) * 64 / (bits - 1)) {
+            throw std::length_error("bigint exceeds the maximum number of limbs");
+        }
+        bool powerOfTwo = std::popcount(base.limbs.back()) == 1
+                          && std::all_of(base.limbs.begin(), base.limbs.end() - 1, [](limb v) { return v == 0; });
+        bigint res;
+        if (powerOfTwo) {
+            res = shiftBits(bigint(1), (bits - 1) * exponent, true);
+        } else {
+            bigint magnitude = base;
+            magnitude.negative = false;
+            res = magnitude;
+            for (int bit = 62 - std::countl_zero(exponent); bit >= 0; --bit) {
+                res = squareOf(res);
+                if ((exponent >> bit) & 1) {
+                    res *= magnitude;
+                }
+            }
+        }
+        res.negative = sign;
+        return res;
+    }
+    friend bigint gcd(const bigint &a, const bigint &b);
+    friend bool is_probable_prime(const bigint &n, size_t rounds);
+    friend bigint next_prime(const bigint &n, size_t rounds);
+    friend std::tuple<bigint, bigint, bigint> ext_gcd(const bigint &a, const bigint &b);
+    template <class Range>
+    friend bigint product(const Range &values);
+    friend bigint factorial(uint64_t n);
+    friend bigint binomial(uint64_t n, uint64_t k);
+    friend bigint primorial(uint64_t n);
+    /**
+     * @brief Integer square root.
+     * @param x A non-negative value.
+     * @return floor(sqrt(x)).
+     * @throws std::domain_error if x is negative.
+     */
+    friend bigint isqrt(const bigint &x){
+        if (x.negative) {
+            throw std::domain_error("Square root of negative number");
+        }
+        if (x.limbs.empty()) {
+            return bigint();
+        }
+        return rootFloor(x, 2);
+    }
+    /**
+     * @brief Integer k-th root, rounded towards zero like operator/.
+     * @param x The radicand; it may be negative for odd k.
+     * @param k The degree, at least 1.
+     * @return The k-th root of |x| rounded down, with the sign of x.
+     * @throws std::domain_error if k is zero, or x is negative and k even.
+     */
+    friend bigint iroot(const bigint &x, uint64_t k){
+        if (k == 0) {
+            throw std::domain_error("Zero root");
+        }
+        if (x.negative && k % 2 == 0) {
+            throw std::domain_error("Even root of negative number");
+        }
+        if (x.limbs.empty() || k == 1) {
+            return x;
+        }
+        bigint magnitude = x;
+        magnitude.negative = false;
+        bigint res = rootFloor(magnitude, k);
+        res.negative = x.negative;
+        return res;
+    }
+    /**
+     * @brief Size in bytes of the record written by write_binary().
+     */
+    size_t binary_size() const {
+        return (limbs.size() + 1) * sizeof(limb);
+    }
+    /**
+     * @brief Writes the compact binary record: an 8-byte header followed by the raw limbs.
+     *
+     * The header holds the limb count in its low 32 bits and the sign in bit 32;
+     * the header and limbs are little-endian 64-bit words, so records stay
+     * 8-byte aligned when written back to back.
+     * @param out The stream to write to.
+     */
+    void write_binary(std::ostream &out) const {
+        limb header = bigint_detail::littleEndian(limbs.size() | (negative ? bigint_detail::NEGATIVE_FLAG : 0));
+        out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        if constexpr (std::endian::native == std::endian::little) {
+            out.write(reinterpret_cast<const char *>(limbs.data()),
+                      static_cast<std::streamsize>(limbs.size() * sizeof(limb)));
+        } else {
+            for (limb value : limbs) {
+                value = bigint_detail::littleEndian(value);
+                out.write(reinterpret_cast<const char *>(&value), sizeof(value));
+            }
+        }
+    }
+    /**
+     * @brief Reads one record written by write_binary().
+     * @param in The stream to read from.
+     * @return The decoded bigint.
+     * @throws std::invalid_argument if the record is truncated or not canonical.
+     */
+    static bigint read_binary(std::istream &in) {
+        limb header;
+        if (!in.read(reinterpret_cast<char *>(&header), sizeof(header))) {
+            throw std::invalid_argument("Truncated binary bigint");
+        }
+        header = bigint_detail::littleEndian(header);
+        if (header >> 33 != 0) {
+            throw std::invalid_argument("Malformed binary bigint");
+        }
+        size_t count = static_cast<uint32_t>(header);
+        bigint res;
+        // Grow geometrically as data arrives, so a corrupt count cannot force a huge allocation up front.
+        for (size_t done = 0; done < count;) {
+            size_t step = std::min(count - done, std::max<size_t>(done, 1 << 16));
+            res.limbs.resize(done + step);
+            if (!in.read(reinterpret_cast<char *>(res.limbs.data() + done),
+                         static_cast<std::streamsize>(step * sizeof(limb)))) {
+                throw std::invalid_argument("Truncated binary bigint");
+            }
+            done += step;
+        }
+        if constexpr (std::endian::native == std::endian::big) {
+            for (limb &value : res.limbs) {
+                value = bigint_detail::littleEndian(value);
+            }
+        }
+        res.negative = (header & bigint_detail::NEGATIVE_FLAG) != 0;
+        if ((count > 0 && res.limbs.back() == 0) || (count == 0 && res.negative)) {
+            throw std::invalid_argument("Malformed binary bigint");
+        }
+        return res;
+    }
+    /**
+     * @brief Assigns a lazy sum, evaluated in one pass into the existing storage.
+     * @param expr The expression built with lazy().
+     * @return A reference to the current bigint.
+     */
+    template <size_t N>
+    bigint &operator=(const bigint_sum<N> &expr){
+        expr.evaluateInto(*this, false, false);
+        return *this;
+    }
+    /**
+     * @brief Adds a lazy sum in one pass, without materializing it.
+     * @param expr The expression built with lazy().
+     * @return A reference to the current bigint.
+     */
+    template <size_t N>
+    bigint &operator+=(const bigint_sum<N> &expr){
+        expr.evaluateInto(*this, true, false);
+        return *this;
+    }
+    /**
+     * @brief Subtracts a lazy sum in one pass, without materializing it.
+     * @param expr The expression built with lazy().
+     * @return A reference to the current bigint.
+     */
+    template <size_t N>
+    bigint &operator-=(const bigint_sum<N> &expr){
+        expr.evaluateInto(*this, true, true);
+        return *this;
+    }
+    /**
+     * @brief Fused multiply-accumulate: acc += lazy(a) * b.
+     * @param expr The product built with lazy(a) * b.
+     * @return A reference to the current bigint.
+     */
+    bigint &operator+=(const bigint_product &expr);
+    /**
+     * @brief Fused multiply-subtract: acc -= lazy(a) * b.
+     * @param expr The product built with lazy(a) * b.
+     * @return A reference to the current bigint.
+     */
+    bigint &operator-=(const bigint_product &expr);
+
+    template <size_t N>
+    friend class bigint_sum;
+    friend class bigint_product;
+    friend class bigint_batch;
+    friend class bigint_modulus;
+    friend class bigint_view;
+    friend class bigint_parser;
+    template <size_t Bits, bool Signed>
+    friend class wide_int;
+
+      /**
+     * @brief Unary negation operator.
+     * @return A new bigint representing the negated value.
+     */
+
+    bigint operator-() const &{
+        bigint res = *this;
+        if (!res.limbs.empty()) {
+            res.negative = !res.negative;
+        }
+        return res;
+    }
+    /**
+     * @brief Negates a temporary by flipping its sign, without copying the limbs.
+     */
+    bigint operator-() &&{
+        negative = !negative && !limbs.empty();
+        return std::move(*this);
+    }
+    /**
+     * @brief Overloaded equality comparison operator.
+     * @param num The bigint to compare with.
+     * @return True if both bigints are equal, otherwise false.
+     */
+
+    bool operator==(const bigint &num) const{
+        bigint_detail::recordOp(bigint_op::compare, std::max(limbs.size(), num.limbs.size()));
+        return negative == num.negative && limbs == num.limbs;
+    }
+      /**
+     * @brief Overloaded inequality comparison operator.
+     * @param num The bigint to compare with.
+     * @return True if both bigints are not equal.
+     */
+    bool operator!=(const bigint &num) const{
+        return !(*this == num);
+    }
+     /**
+     * @brief Overloaded less-than comparison operator.
+     * @param num The bigint to compare with.
+     * @return True if the current bigint is less than the other.
+     */
+    bool operator<(const bigint &num) const {
+        return compare(num) < 0;
+    }
+
+    /**
+     * @brief Overloaded greater-than comparison operator.
+     * @param num The bigint to compare with.
+     * @return True if the current bigint is greater than the other.
+     */
+    bool operator>(const bigint &num) const{
+        return compare(num) > 0;
+    }
+     /**
+     * @brief Overloaded less-than-or-equal comparison operator.
+     * @param num The bigint to compare with.
+     * @return True if the current bigint is less than or equal to the other.
+     */
+    bool operator<=(const bigint &num) const{
+        return compare(num) <= 0;
+    }
+     /**
+     * @brief Overloaded greater-than-or-equal comparison operator.
+     * @param num The bigint to compare with.
+     * @return True if the current bigint is greater than or equal to the other.
+     */
+    bool operator>=(const bigint &num) const{
+        return compare(num) >= 0;
+    }
+     /**
+     * @brief Pre-increment operator; only the carry is propagated.
+     * @return A reference to the incremented bigint.
+     */
+    bigint &operator++(){
+        addWordInPlace(1, false);
+        return *this;
+    }
+      /**
+     * @brief Post-increment operator.
+     * @return The bigint before incrementing.
+     */
+    bigint operator++(int){
+        bigint res = *this;
+        addWordInPlace(1, false);
+        return res;
+    }
+     /**
+     * @brief Pre-decrement operator; only the borrow is propagated.
+     * @return A reference to the decremented bigint.
+     */
+    bigint &operator--(){
+        addWordInPlace(1, true);
+        return *this;
+    }
+    /**
+     * @brief Post-decrement operator.
+     * @return The bigint before decrementing.
+     */
+    bigint operator--(int){
+        bigint res = *this;
+        addWordInPlace(1, true);
+        return res;
+    }
+    /**
+     * @brief Adds a 64-bit integer without converting it to a bigint.
+     * @param num The integer to add.
+     * @return A reference to the current bigint.
+     */
+    bigint &operator+=(const int64_t num){
+        bigint_detail::recordOp(bigint_op::add, limbs.size());
+        addWordInPlace(wordMagnitude(num), num < 0);
+        return *this;
+    }
+    /**
+     * @brief Subtracts a 64-bit integer without converting it to a bigint.
+     * @param num The integer to subtract.
+     * @return A reference to the current bigint.
+     */
+    bigint &operator-=(const int64_t num){
+        bigint_detail::recordOp(bigint_op::sub, limbs.size());
+        addWordInPlace(wordMagnitude(num), num >= 0);
+        return *this;
+    }
+    /**
+     * @brief Multiplies by a 64-bit integer with a single-limb kernel.
+     * @param num The integer to multiply with.
+     * @return A reference to the current bigint.
+     */
+    bigint &operator*=(const int64_t num){
+        bigint_detail::recordOp(bigint_op::mul, limbs.size());
+        mulWordInPlace(wordMagnitude(num), num < 0);
+        return *this;
+    }
+    /**
+     * @brief Divides by a 64-bit integer, rounding towards zero.
+     * @param num The divisor.
+     * @return A reference to the current bigint.
+     * @throws std::domain_error if num is zero.
+     */
+    bigint &operator/=(const int64_t num){
+        bigint_detail::recordOp(bigint_op::div, limbs.size());
+        divWordInPlace(wordMagnitude(num), num < 0);
+        return *this;
+    }
+    /**
+     * @brief Replaces the value by its remainder modulo a 64-bit integer; the sign is the dividend's.
+     * @param num The divisor.
+     * @return A reference to the current bigint.
+     * @throws std::domain_error if num is zero.
+     */
+    bigint &operator%=(const int64_t num){
+        bigint_detail::recordOp(bigint_op::mod, limbs.size());
+        bool sign = negative;
+        limb rem = divWordInPlace(wordMagnitude(num), num < 0);
+        limbs.clear();
+        negative = false;
+        addWordInPlace(rem, sign);
+        return *this;
+    }
+    /**
+     * @brief Adds a 64-bit integer.
+     * @param num The integer to add.
+     * @return A new bigint.
+     */
+    bigint operator+(const int64_t num) const &{
+        bigint res = *this;
+        res += num;
+        return res;
+    }
+    bigint operator+(const int64_t num) &&{
+        *this += num;
+        return std::move(*this);
+    }
+    /**
+     * @brief Subtracts a 64-bit integer.
+     * @param num The integer to subtract.
+     * @return A new bigint.
+     */
+    bigint operator-(const int64_t num) const &{
+        bigint res = *this;
+        res -= num;
+        return res;
+    }
+    bigint operator-(const int64_t num) &&{
+        *this -= num;
+        return std::move(*this);
+    }
+    /**
+     * @brief Multiplies by a 64-bit integer.
+     * @param num The integer to multiply with.
+     * @return A new bigint.
+     */
+    bigint operator*(const int64_t num) &&{
+        *this *= num;
+        return std::move(*this);
+    }
+    bigint operator*(const int64_t num) const &{
+        bigint_detail::recordOp(bigint_op::mul, limbs.size());
+        bigint res;
+        limb factor = wordMagnitude(num);
+        if (factor == 0 || limbs.empty()) {
+            return res;
+        }
+        res.limbs.resize(limbs.size() + 1);
+        res.limbs[limbs.size()] = bigint_detail::mulLimb(res.limbs.data(), limbs.data(), limbs.size(), factor);
+        res.negative = negative != (num < 0);
+        res.removeZeros();
+        return res;
+    }
+    /**
+     * @brief Divides by a 64-bit integer, rounding towards zero.
+     * @param num The divisor.
+     * @return A new bigint.
+     * @throws std::domain_error if num is zero.
+     */
+    bigint operator/(const int64_t num) const &{
+        bigint res = *this;
+        res /= num;
+        return res;
+    }
+    bigint operator/(const int64_t num) &&{
+        *this /= num;
+        return std::move(*this);
+    }
+    /**
+     * @brief Remainder modulo a 64-bit integer; the result has the sign of the dividend.
+     * @param num The divisor.
+     * @return A new bigint.
+     * @throws std::domain_error if num is zero.
+     */
+    bigint operator%(const int64_t num) const{
+        bigint_detail::recordOp(bigint_op::mod, limbs.size());
+        limb d = wordMagnitude(num);
+        if (d == 0) {
+            throw std::domain_error("Division by zero");
+        }
+        limb rem = bigint_detail::divLimb(nullptr, limbs.data(), limbs.size(), d);
+        bigint res;
+        res.addWordInPlace(rem, negative);
+        return res;
+    }
+    friend bigint operator+(const int64_t a, const bigint &b){
+        return b + a;
+    }
+    friend bigint operator+(const int64_t a, bigint &&b){
+        return std::move(b) + a;
+    }
+    friend bigint operator-(const int64_t a, const bigint &b){
+        bigint res = -b;
+        res += a;
+        return res;
+    }
+    friend bigint operator-(const int64_t a, bigint &&b){
+        bigint res = -std::move(b);
+        res += a;
+        return res;
+    }
+    friend bigint operator*(const int64_t a, const bigint &b){
+        return b * a;
+    }
+    friend bigint operator*(const int64_t a, bigint &&b){
+        return std::move(b) * a;
+    }
+    friend bigint operator/(const int64_t a, const bigint &b){
+        return bigint(a) / b;
+    }
+    friend bigint operator%(const int64_t a, const bigint &b){
+        return bigint(a) % b;
+    }
+    /**
+     * @brief Comparisons with a 64-bit integer, in either order, without converting it.
+     */
+    bool operator==(const int64_t num) const{
+        return compare(num) == 0;
+    }
+    bool operator!=(const int64_t num) const{
+        return compare(num) != 0;
+    }
+    bool operator<(const int64_t num) const{
+        return compare(num) < 0;
+    }
+    bool operator>(const int64_t num) const{
+        return compare(num) > 0;
+    }
+    bool operator<=(const int64_t num) const{
+        return compare(num) <= 0;
+    }
+    bool operator>=(const int64_t num) const{
+        return compare(num) >= 0;
+    }
+    friend bool operator==(const int64_t a, const bigint &b){
+        return b.compare(a) == 0;
+    }
+    friend bool operator!=(const int64_t a, const bigint &b){
+        return b.compare(a) != 0;
+    }
+    friend bool operator<(const int64_t a, const bigint &b){
+        return b.compare(a) > 0;
+    }
+    friend bool operator>(const int64_t a, const bigint &b){
+        return b.compare(a) < 0;
+    }
+    friend bool operator<=(const int64_t a, const bigint &b){
+        return b.compare(a) >= 0;
+    }
+    friend bool operator>=(const int64_t a, const bigint &b){
+        return b.compare(a) <= 0;
+    }
+
+
+};
+
+/**
+ * @brief A lazy signed sum of N bigint operands.
+ *
+ * Built with lazy(a) + b - c ...; nothing is computed until the sum is
+ * assigned, converted to bigint or accumulated with += / -=, and then all
+ * operands are added limb by limb in a single pass. The expression stores
+ * pointers, so it should be consumed within the full expression that
+ * creates it.
+ */
+template <size_t N>
+class bigint_sum {
+public:
+    bigint_sum(const std::array<const bigint *, N> &operands, const std::array<bool, N> &negated)
+        : terms(operands), negate(negated) {}
+
+    const bigint &term(size_t i) const { return *terms[i]; }
+    bool negated(size_t i) const { return negate[i]; }
+
+    /**
+     * @brief Evaluates the sum into dest, optionally on top of its current value.
+     * @param dest The destination.
+     * @param keepDest Whether to add to the current value of dest.
+     * @param negateAll Whether to subtract the whole sum instead.
+     */
+    void evaluateInto(bigint &dest, bool keepDest, bool negateAll) const {
+        std::array<bool, N> signs = negate;
+        if (negateAll) {
+            for (bool &sign : signs) {
+                sign = !sign;
+            }
+        }
+        bigint::fusedSum(dest, terms, signs, keepDest);
+    }
+    /**
+     * @brief Materializes the sum.
+     */
+    operator bigint() const {
+        bigint res;
+        evaluateInto(res, false, false);
+        return res;
+    }
+    /**
+     * @brief Appends one more operand.
+     * @param value The operand.
+     * @param subtract Whether it is subtracted.
+     * @param negateOthers Whether the existing operands flip sign (for x - sum).
+     */
+    bigint_sum<N + 1> append(const bigint &value, bool subtract, bool negateOthers = false) const {
+        std::array<const bigint *, N + 1> operands;
+        std::array<bool, N + 1> negated;
+        for (size_t i = 0; i < N; ++i) {
+            operands[i] = terms[i];
+            negated[i] = negate[i] != negateOthers;
+        }
+        operands[N] = &value;
+        negated[N] = subtract;
+        return bigint_sum<N + 1>(operands, negated);
+    }
+
+    friend bigint_sum<N + 1> operator+(const bigint_sum &x, const bigint &y) {
+        return x.append(y, false);
+    }
+    friend bigint_sum<N + 1> operator-(const bigint_sum &x, const bigint &y) {
+        return x.append(y, true);
+    }
+    friend bigint_sum<N + 1> operator+(const bigint &x, const bigint_sum &y) {
+        return y.append(x, false);
+    }
+    friend bigint_sum<N + 1> operator-(const bigint &x, const bigint_sum &y) {
+        return y.append(x, false, true);
+    }
+
+private:
+    std::array<const bigint *, N> terms;
+    std::array<bool, N> negate;
+};
+
+/**
+ * @brief Concatenates two lazy sums.
+ */
+template <size_t N, size_t M>
+bigint_sum<N + M> operator+(const bigint_sum<N> &x, const bigint_sum<M> &y) {
+    std::array<const bigint *, N + M> operands;
+    std::array<bool, N + M> negated;
+    for (size_t i = 0; i < N; ++i) {
+        operands[i] = &x.term(i);
+        negated[i] = x.negated(i);
+    }
+    for (size_t i = 0; i < M; ++i) {
+        operands[N + i] = &y.term(i);
+        negated[N + i] = y.negated(i);
+    }
+    return bigint_sum<N + M>(operands, negated);
+}
+
+/**
+ * @brief Subtracts one lazy sum from another.
+ */
+template <size_t N, size_t M>
+bigint_sum<N + M> operator-(const bigint_sum<N> &x, const bigint_sum<M> &y) {
+    std::array<const bigint *, N + M> operands;
+    std::array<bool, N + M> negated;
+    for (size_t i = 0; i < N; ++i) {
+        operands[i] = &x.term(i);
+        negated[i] = x.negated(i);
+    }
+    for (size_t i = 0; i < M; ++i) {
+        operands[N + i] = &y.term(i);
+        negated[N + i] = !y.negated(i);
+    }
+    return bigint_sum<N + M>(operands, negated);
+}
+
+/**
+ * @brief Multiplies a lazy sum by a bigint, as in (lazy(b) + c) * a.
+ *
+ * The sum is evaluated in one fused pass and then multiplied; a * (lazy(b) + c)
+ * reaches the same path through the conversion to bigint.
+ */
+template <size_t N>
+    requires(N > 1)
+bigint operator*(const bigint_sum<N> &x, const bigint &y) {
+    return static_cast<bigint>(x) * y;
+}
+
+/**
+ * @brief A lazy product a * b, built with lazy(a) * b.
+ *
+ * Converting it gives the ordinary product; accumulating it with += or -=
+ * runs the fused multiply-accumulate kernel instead.
+ */
+class bigint_product {
+public:
+    bigint_product(const bigint &x, const bigint &y) : left(&x), right(&y) {}
+
+    /**
+     * @brief Materializes the product.
+     */
+    operator bigint() const {
+        return *left * *right;
+    }
+    friend bigint operator+(const bigint &x, const bigint_product &y) {
+        bigint res = x;
+        res += y;
+        return res;
+    }
+    friend bigint operator+(const bigint_product &x, const bigint &y) {
+        return y + x;
+    }
+    friend bigint operator-(const bigint &x, const bigint_product &y) {
+        bigint res = x;
+        res -= y;
+        return res;
+    }
+
+private:
+    const bigint *left;
+    const bigint *right;
+
+    friend class bigint;
+};
+
+/**
+ * @brief Starts a lazy expression; existing eager code is unaffected.
+ * @param value The first operand.
+ * @return A one-term lazy sum, which also multiplies into a lazy product.
+ */
+inline bigint_sum<1> lazy(const bigint &value) {
+    return bigint_sum<1>({&value}, {false});
+}
+
+/**
+ * @brief Builds a lazy product from lazy(a) * b.
+ */
+inline bigint_product operator*(const bigint_sum<1> &x, const bigint &y) {
+    if (x.negated(0)) {
+        throw std::logic_error("lazy(a) * b expects a single positive operand");
+    }
+    return bigint_product(x.term(0), y);
+}
+
+inline bigint &bigint::operator+=(const bigint_product &expr) {
+    fusedMulAdd(*expr.left, *expr.right, false);
+    return *this;
+}
+
+inline bigint &bigint::operator-=(const bigint_product &expr) {
+    fusedMulAdd(*expr.left, *expr.right, true);
+    return *this;
+}
+
+/**
+ * @brief A unimodular 2x2 matrix M with (a; b) = M (a'; b') for the original and reduced GCD operands.
+ */
+struct bigint::gcdMatrix {
+    bigint m00 = 1, m01 = 0, m10 = 0, m11 = 1;
+    /// The determinant, +1 or -1.
+    int det = 1;
+
+    /**
+     * @brief M = M [[a, b], [c, d]] for a small matrix with determinant smallDet.
+     */
+    void mulSmall(int64_t a, int64_t b, int64_t c, int64_t d, int smallDet) {
+        bigint n00 = m00 * a + m01 * c;
+        bigint n01 = m00 * b + m01 * d;
+        bigint n10 = m10 * a + m11 * c;
+        bigint n11 = m10 * b + m11 * d;
+        m00 = std::move(n00);
+        m01 = std::move(n01);
+        m10 = std::move(n10);
+        m11 = std::move(n11);
+        det *= smallDet;
+    }
+    /**
+     * @brief M = M N.
+     */
+    void mul(const gcdMatrix &n) {
+        bigint n00 = m00 * n.m00 + m01 * n.m10;
+        bigint n01 = m00 * n.m01 + m01 * n.m11;
+        bigint n10 = m10 * n.m00 + m11 * n.m10;
+        bigint n11 = m10 * n.m01 + m11 * n.m11;
+        m00 = std::move(n00);
+        m01 = std::move(n01);
+        m10 = std::move(n10);
+        m11 = std::move(n11);
+        det *= n.det;
+    }
+    /**
+     * @brief Follows a swap of the operands.
+     */
+    void swapColumns() {
+        std::swap(m00, m01);
+        std::swap(m10, m11);
+        det = -det;
+    }
+    /**
+     * @brief Follows a sign change of operand j.
+     */
+    void negateColumn(int j) {
+        bigint &top = j == 0 ? m00 : m01;
+        bigint &bottom = j == 0 ? m10 : m11;
+        top = -top;
+        bottom = -bottom;
+        det = -det;
+    }
+};
+
+/**
+ * @brief Lehmer's step: runs Euclid on the leading 63 bits of x >= y > 0.
+ *
+ * The quotients are kept only while both bounds of Collins' condition agree,
+ * so they match the quotients of the full numbers. On success, cofactors
+ * holds [[A, B], [C, D]] with (A x + B y, C x + D y) the operands after
+ * those steps.
+ * @return False if not even one quotient could be determined.
+ */
+inline bool bigint::lehmerCofactors(const bigint &x, const bigint &y, int64_t cofactors[4]) {
+    using bigint_detail::sdlimb;
+    size_t bits = x.bitLength();
+    size_t shift = bits > 63 ? bits - 63 : 0;
+    sdlimb xh = static_cast<sdlimb>(x.bitsAt(shift));
+    sdlimb yh = static_cast<sdlimb>(y.bitsAt(shift));
+    sdlimb a = 1, b = 0, c = 0, d = 1;
+    while (yh + c != 0 && yh + d != 0) {
+        sdlimb q = (xh + a) / (yh + c);
+        if (q != (xh + b) / (yh + d)) {
+            break;
+        }
+        sdlimb t = a - q * c;
+        a = c;
+        c = t;
+        t = b - q * d;
+        b = d;
+        d = t;
+        t = xh - q * yh;
+        xh = yh;
+        yh = t;
+    }
+    if (b == 0) {
+        return false;
+    }
+    cofactors[0] = static_cast<int64_t>(a);
+    cofactors[1] = static_cast<int64_t>(b);
+    cofactors[2] = static_cast<int64_t>(c);
+    cofactors[3] = static_cast<int64_t>(d);
+    return true;
+}
+
+/**
+ * @brief Performs one Lehmer step or one division step on positive a and b.
+ *
+ * With s > 0 (half-GCD mode) a step is only taken if both operands keep more
+ * than s limbs; with s = 0 the operands are reduced down to zero.
+ * @param m The matrix to update, or null when no cofactors are needed.
+ * @return False if no step was possible.
+ */
+inline bool bigint::gcdStep(bigint &a, bigint &b, size_t s, gcdMatrix *m) {
+    if (a < b) {
+        std::swap(a, b);
+        if (m != nullptr) {
+            m->swapColumns();
+        }
+    }
+    if (b.limbs.empty() || (s > 0 && b.limbs.size() <= s)) {
+        return false;
+    }
+    int64_t c[4];
+    if (lehmerCofactors(a, b, c)) {
+        bigint x = a * c[0] + b * c[1];
+        bigint y = a * c[2] + b * c[3];
+        if (!x.negative && !y.negative && (s == 0 || (x.limbs.size() > s && y.limbs.size() > s))) {
+            a = std::move(x);
+            b = std::move(y);
+            if (m != nullptr) {
+                // The step matrix [[A, B], [C, D]] has determinant AD - BC = +-1, so its inverse is integral.
+                int stepDet = static_cast<bigint_detail::sdlimb>(c[0]) * c[3] > static_cast<bigint_detail::sdlimb>(c[1]) * c[2] ? 1 : -1;
+                m->mulSmall(stepDet * c[3], -stepDet * c[1], -stepDet * c[2], stepDet * c[0], stepDet);
+            }
+            return true;
+        }
+    }
+    std::pair<bigint, bigint> qr = divideSigned(a, b);
+    if (s > 0 && qr.second.limbs.size() <= s) {
+        if (qr.first == 1) {
+            return false;
+        }
+        --qr.first;
+        qr.second += b;
+    }
+    a = std::move(qr.second);
+    if (m != nullptr) {
+        m->m01 += m->m00 * qr.first;
+        m->m11 += m->m10 * qr.first;
+    }
+    return true;
+}
+
+/**
+ * @brief Replaces (a; b) by M^-1 (a; b), keeping both non-negative by flipping columns of M.
+ */
+inline void bigint::applyInverse(bigint &a, bigint &b, gcdMatrix &m) {
+    bigint x = m.m11 * a - m.m01 * b;
+    bigint y = m.m00 * b - m.m10 * a;
+    if (m.det < 0) {
+        x = -x;
+        y = -y;
+    }
+    if (x.negative) {
+        x = -x;
+        m.negateColumn(0);
+    }
+    if (y.negative) {
+        y = -y;
+        m.negateColumn(1);
+    }
+    a = std::move(x);
+    b = std::move(y);
+}
+
+/**
+ * @brief Schoenhage's half-GCD: reduces n-limb a and b to about n / 2 limbs each.
+ *
+ * The leading half of the operands is reduced recursively and the resulting
+ * matrix applied to the full numbers, twice, with single steps in between
+ * (the structure of Moeller's algorithm). Each reduction is a unimodular
+ * matrix, so the GCD is preserved however far a reduction goes; the size
+ * bound s only keeps the matrices small. The cost is O(M(n) log n).
+ * @param m Receives the matrix of the reduction (initially the identity).
+ * @return False if no reduction was possible.
+ */
+inline bool bigint::hgcd(bigint &a, bigint &b, gcdMatrix &m) {
+    size_t n = std::max(a.limbs.size(), b.limbs.size());
+    size_t s = n / 2 + 1;
+    if (std::min(a.limbs.size(), b.limbs.size()) <= s) {
+        return false;
+    }
+    bool progress = false;
+    if (n >= std::max<size_t>(bigint_tuning::hgcdThreshold, 8)) {
+        size_t p = n / 2;
+        bigint ah = shiftLimbs(a, p, false);
+        bigint bh = shiftLimbs(b, p, false);
+        gcdMatrix m1;
+        if (hgcd(ah, bh, m1)) {
+            applyInverse(a, b, m1);
+            m.mul(m1);
+            progress = true;
+        }
+        while (std::max(a.limbs.size(), b.limbs.size()) > 3 * n / 4 + 1) {
+            if (!gcdStep(a, b, s, &m)) {
+                return progress;
+            }
+            progress = true;
+        }
+        size_t nn = std::max(a.limbs.size(), b.limbs.size());
+        if (nn > s + 2) {
+            p = 2 * s - nn + 1;
+            ah = shiftLimbs(a, p, false);
+            bh = shiftLimbs(b, p, false);
+            gcdMatrix m2;
+            if (hgcd(ah, bh, m2)) {
+                applyInverse(a, b, m2);
+                m.mul(m2);
+            }
+        }
+    }
+    while (gcdStep(a, b, s, &m)) {
+        progress = true;
+    }
+    return progress;
+}
+
+/**
+ * @brief Reduces non-negative a and b to (gcd, 0), tracking the matrix when m is not null.
+ */
+inline void bigint::gcdReduce(bigint &a, bigint &b, gcdMatrix *m) {
+    for (;;) {
+        if (a < b) {
+            std::swap(a, b);
+            if (m != nullptr) {
+                m->swapColumns();
+            }
+        }
+        if (b.limbs.empty()) {
+            return;
+        }
+        if (m == nullptr && a.limbs.size() == 1) {
+            // Binary GCD on single words.
+            limb x = a.limbs[0], y = b.limbs[0];
+            int shift = std::countr_zero(x | y);
+            x >>= std::countr_zero(x);
+            while (y != 0) {
+                y >>= std::countr_zero(y);
+                if (x > y) {
+                    std::swap(x, y);
+                }
+                y -= x;
+            }
+            a.limbs[0] = x << shift;
+            b.limbs.clear();
+            return;
+        }
+        if (b.limbs.size() >= std::max<size_t>(bigint_tuning::hgcdThreshold, 8) && a.limbs.size() <= b.limbs.size() + 1) {
+            gcdMatrix h;
+            if (hgcd(a, b, h)) {
+                if (m != nullptr) {
+                    m->mul(h);
+                }
+                continue;
+            }
+        }
+        gcdStep(a, b, 0, m);
+    }
+}
+
+/**
+ * @brief Greatest common divisor, always non-negative; gcd(0, 0) is 0.
+ *
+ * Lehmer steps for small and medium operands, half-GCD from
+ * bigint_tuning::hgcdThreshold limbs.
+ */
+inline bigint gcd(const bigint &a, const bigint &b) {
+    bigint x = a, y = b;
+    x.negative = false;
+    y.negative = false;
+    bigint::gcdReduce(x, y, nullptr);
+    return x;
+}
+
+/**
+ * @brief Least common multiple, always non-negative; 0 if either argument is 0.
+ */
+inline bigint lcm(const bigint &a, const bigint &b) {
+    if (a == 0 || b == 0) {
+        return bigint();
+    }
+    bigint res = a / gcd(a, b) * b;
+    return res < 0 ? -res : res;
+}
+
+/**
+ * @brief Extended GCD: returns (g, x, y) with a x + b y = g = gcd(a, b).
+ *
+ * For b != 0, x is normalized to 0 <= x < |b| / g, which makes the
+ * cofactors the smallest ones. For b = 0 the result is (|a|, sign(a), 0).
+ */
+inline std::tuple<bigint, bigint, bigint> ext_gcd(const bigint &a, const bigint &b) {
+    if (b == 0) {
+        return {a < 0 ? -a : a, bigint(a < 0 ? -1 : (a == 0 ? 0 : 1)), bigint()};
+    }
+    bigint g = a, zero = b;
+    g.negative = false;
+    zero.negative = false;
+    bigint::gcdMatrix m;
+    bigint::gcdReduce(g, zero, &m);
+    // (|a|; |b|) = M (g; 0), so g = det (m11 |a| - m01 |b|).
+    bigint x = m.det > 0 ? m.m11 : -m.m11;
+    if (a < 0) {
+        x = -x;
+    }
+    bigint period = b / g;
+    if (period < 0) {
+        period = -period;
+    }
+    x %= period;
+    if (x < 0) {
+        x += period;
+    }
+    bigint y = (g - a * x) / b;
+    return {std::move(g), std::move(x), std::move(y)};
+}
+
+/**
+ * @brief Inverse of a modulo m.
+ * @return The x in [0, m) with a x = 1 (mod m).
+ * @throws std::domain_error if m is not positive or gcd(a, m) != 1.
+ */
+inline bigint modinv(const bigint &a, const bigint &m) {
+    if (m <= 0) {
+        throw std::domain_error("Modulus must be positive");
+    }
+    auto [g, x, y] = ext_gcd(a, m);
+    if (g != 1) {
+        throw std::domain_error("Value is not invertible");
+    }
+    return m == 1 ? bigint() : x;
+}
+
+/**
+ * @brief A structure-of-arrays container for many bigints with element-wise arithmetic.
+ *
+ * All magnitudes share one contiguous limb pool, addressed through parallel
+ * offset, length and sign arrays, so a batch of n values costs four
+ * allocations instead of n. Element-wise operations size the result pool
+ * once from worst-case lengths, then fill disjoint slices of it using the
+ * same dispatched limb kernels as bigint. With bigint_tuning::threads > 1
+ * and enough total limbs, the element range is split over the shared pool.
+ */
+class bigint_batch {
+public:
+    using limb = bigint_detail::limb;
+
+    /**
+     * @brief Creates an empty batch.
+     * @param resource Where the arrays are allocated; it must outlive the batch.
+     */
+    explicit bigint_batch(std::pmr::memory_resource *resource = bigint_detail::currentResource())
+        : pool(resource), offsets(resource), lengths(resource), signs(resource) {}
+    /**
+     * @brief Creates a batch holding copies of values.
+     * @param values The values to store.
+     * @param resource Where the arrays are allocated; it must outlive the batch.
+     */
+    explicit bigint_batch(const std::vector<bigint> &values,
+                          std::pmr::memory_resource *resource = bigint_detail::currentResource())
+        : bigint_batch(resource) {
+        size_t limbs = 0;
+        for (const bigint &value : values) {
+            limbs += value.limbs.size();
+        }
+        reserve(values.size(), limbs);
+        for (const bigint &value : values) {
+            push_back(value);
+        }
+    }
+
+    /**
+     * @brief Returns the number of values.
+     */
+    size_t size() const {
+        return lengths.size();
+    }
+    bool empty() const {
+        return lengths.empty();
+    }
+    /**
+     * @brief Reserves room for count values totalling limbs limbs.
+     */
+    void reserve(size_t count, size_t limbs) {
+        pool.reserve(limbs);
+        offsets.reserve(count);
+        lengths.reserve(count);
+        signs.reserve(count);
+    }
+    void clear() {
+        pool.clear();
+        offsets.clear();
+        lengths.clear();
+        signs.clear();
+    }
+    /**
+     * @brief Appends a copy of value.
+     */
+    void push_back(const bigint &value) {
+        offsets.push_back(pool.size());
+        pool.insert(pool.end(), value.limbs.begin(), value.limbs.end());
+        lengths.push_back(static_cast<uint32_t>(value.limbs.size()));
+        signs.push_back(value.negative);
+    }
+    /**
+     * @brief Returns element i as a bigint.
+     */
+    bigint operator[](size_t i) const {
+        bigint value;
+        value.limbs.assign(data(i), data(i) + lengths[i]);
+        value.negative = signs[i] != 0;
+        return value;
+    }
+    /**
+     * @brief Copies every element out into a vector of bigints.
+     */
+    std::vector<bigint> to_vector() const {
+        std::vector<bigint> values;
+        values.reserve(size());
+        for (size_t i = 0; i < size(); ++i) {
+            values.push_back((*this)[i]);
+        }
+        return values;
+    }
+
+    /**
+     * @brief Element-wise sum of two batches of equal size.
+     */
+    friend bigint_batch operator+(const bigint_batch &a, const bigint_batch &b) {
+        return elementwise(a, b, operation::add);
+    }
+    /**
+     * @brief Element-wise difference of two batches of equal size.
+     */
+    friend bigint_batch operator-(const bigint_batch &a, const bigint_batch &b) {
+        return elementwise(a, b, operation::sub);
+    }
+    /**
+     * @brief Element-wise product of two batches of equal size.
+     */
+    friend bigint_batch operator*(const bigint_batch &a, const bigint_batch &b) {
+        return elementwise(a, b, operation::mul);
+    }
+    /**
+     * @brief Element-wise comparison of two batches of equal size.
+     * @return -1, 0 or 1 per element if a[i] is less than, equal to or greater than b[i].
+     */
+    friend std::vector<int> compare(const bigint_batch &a, const bigint_batch &b) {
+        checkSizes(a, b);
+        std::vector<int> res(a.size());
+        forEachChunk(a.size(), a.pool.size() + b.pool.size(), [&](size_t first, size_t last) {
+            for (size_t i = first; i < last; ++i) {
+                res[i] = compareElements(a, b, i);
+            }
+        });
+        return res;
+    }
+
+private:
+    enum class operation { add, sub, mul };
+
+    /// Magnitudes of all elements, back to back; results may leave unused limbs after an element.
+    std::pmr::vector<limb> pool;
+    /// Start of each element's limbs in pool.
+    std::pmr::vector<size_t> offsets;
+    /// Number of limbs in each element, without high zero limbs. Zero has length 0.
+    std::pmr::vector<uint32_t> lengths;
+    /// Sign of each element (1 for negative); zero is never negative.
+    std::pmr::vector<uint8_t> signs;
+
+    const limb *data(size_t i) const {
+        return pool.data() + offsets[i];
+    }
+
+    static void checkSizes(const bigint_batch &a, const bigint_batch &b) {
+        if (a.size() != b.size()) {
+            throw std::invalid_argument("Batch sizes differ");
+        }
+    }
+    /**
+     * @brief Runs body(first, last) over [0, n), split into chunks on the shared pool when worthwhile.
+     * @param n The number of elements.
+     * @param work The total number of input limbs, compared against bigint_tuning::parallelThreshold.
+     * @param body The per-range work; ranges are disjoint.
+     */
+    template <class F>
+    static void forEachChunk(size_t n, size_t work, F &&body) {
+        bigint_detail::workStealingPool *threadPool = bigint_detail::parallelPool(work);
+        if (threadPool == nullptr || n < 2) {
+            body(size_t{0}, n);
+            return;
+        }
+        size_t chunks = std::min(n, 4 * threadPool->size());
+        std::vector<std::function<void()>> tasks;
+        tasks.reserve(chunks);
+        for (size_t c = 0; c < chunks; ++c) {
+            tasks.emplace_back([&body, c, n, chunks] { body(n * c / chunks, n * (c + 1) / chunks); });
+        }
+        threadPool->run(tasks.data(), tasks.size());
+    }
+    static int compareElements(const bigint_batch &a, const bigint_batch &b, size_t i) {
+        bool aNegative = a.signs[i] != 0;
+        if (aNegative != (b.signs[i] != 0)) {
+            return aNegative ? -1 : 1;
+        }
+        int cmp = bigint_detail::compareLimbs(a.data(i), a.lengths[i], b.data(i), b.lengths[i]);
+        return aNegative ? -cmp : cmp;
+    }
+    static bigint_batch elementwise(const bigint_batch &a, const bigint_batch &b, operation kind) {
+        checkSizes(a, b);
+        size_t n = a.size();
+        bigint_batch res(a.pool.get_allocator().resource());
+        res.offsets.resize(n);
+        res.lengths.resize(n);
+        res.signs.resize(n);
+        size_t total = 0;
+        for (size_t i = 0; i < n; ++i) {
+            res.offsets[i] = total;
+            size_t an = a.lengths[i];
+            size_t bn = b.lengths[i];
+            total += kind == operation::mul ? an + bn : std::max(an, bn) + 1;
+        }
+        res.pool.resize(total);
+        forEachChunk(n, a.pool.size() + b.pool.size(), [&](size_t first, size_t last) {
+            for (size_t i = first; i < last; ++i) {
+                res.computeElement(i, a, b, kind);
+            }
+        });
+        return res;
+    }
+    /**
+     * @brief Writes element i of a (kind) b into this batch's preallocated slice.
+     */
+    void computeElement(size_t i, const bigint_batch &a, const bigint_batch &b, operation kind) {
+        const limb *x = a.data(i);
+        const limb *y = b.data(i);
+        size_t xn = a.lengths[i];
+        size_t yn = b.lengths[i];
+        bool xNegative = a.signs[i] != 0;
+        bool yNegative = (b.signs[i] != 0) != (kind == operation::sub);
+        limb *out = pool.data() + offsets[i];
+        size_t rn = 0;
+        bool negative = false;
+        if (kind == operation::mul) {
+            if (xn != 0 && yn != 0) {
+                bigint_detail::mulLimbs(out, x, xn, y, yn);
+                rn = xn + yn;
+            }
+            negative = xNegative != (b.signs[i] != 0);
+        } else if (xNegative == yNegative) {
+            if (xn < yn) {
+                std::swap(x, y);
+                std::swap(xn, yn);
+            }
+            out[xn] = bigint_detail::addLimbs(out, x, xn, y, yn);
+            rn = xn + 1;
+            negative = xNegative;
+        } else {
+            if (bigint_detail::compareLimbs(x, xn, y, yn) < 0) {
+                std::swap(x, y);
+                std::swap(xn, yn);
+                std::swap(xNegative, yNegative);
+            }
+            bigint_detail::subLimbs(out, x, xn, y, yn);
+            rn = xn;
+            negative = xNegative;
+        }
+        while (rn > 0 && out[rn - 1] == 0) {
+            --rn;
+        }
+        lengths[i] = static_cast<uint32_t>(rn);
+        signs[i] = negative && rn != 0;
+    }
+};
+
+/**
+ * @brief A fixed modulus with precomputed reduction constants for repeated modular arithmetic.
+ *
+ * Construction computes the Barrett reciprocal floor(B^(2n) / m) and, for odd
+ * moduli, the Montgomery constants -m^-1 mod 2^64 and R^2 mod m with R = B^n.
+ * mulmod reduces with Barrett; powmod uses a left-to-right sliding window in
+ * Montgomery form for odd moduli below bigint_tuning::montgomeryThreshold
+ * limbs and Barrett otherwise. The constants and the scratch buffers live in
+ * the context, on the resource given at construction, and the buffers are
+ * reused across calls. reduce, mulmod and powmod therefore modify the context
+ * and are not const; give each thread its own copy.
+ */
+class bigint_modulus {
+public:
+    using limb = bigint_detail::limb;
+
+    /**
+     * @brief Precomputes the constants for modulus.
+     *
+     * The context does not follow bigint_resource_scope: without an explicit
+     * resource it allocates from the process default, so one built inside a
+     * bigint_arena stays valid after the arena is gone.
+     * @param modulus The modulus, which must be positive.
+     * @param resource Where the constants and scratch buffers are allocated; it must outlive the context.
+     */
+    explicit bigint_modulus(const bigint &modulus,
+                            std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+        : m(modulus, resource), n(modulus.limbs.size()), mu(0, resource), mInv(0), rSquared(resource),
+          wide(resource), product(resource), quotient(resource), remainder(resource), table(resource),
+          left(resource), right(resource), accumulator(resource) {
+        if (modulus.negative || modulus.limbs.empty()) {
+            throw std::domain_error("Modulus must be positive");
+        }
+        mu = bigint::reciprocal(m);
+        montgomery = (m.limbs[0] & 1) != 0;
+        if (montgomery) {
+            limb inv = m.limbs[0];
+            for (int i = 0; i < 5; ++i) {
+                inv *= 2 - m.limbs[0] * inv;
+            }
+            mInv = 0 - inv;
+            bigint r2 = 1;
+            r2 = bigint::shiftLimbs(r2, 2 * n, true) % m;
+            rSquared.assign(n, 0);
+            std::copy(r2.limbs.begin(), r2.limbs.end(), rSquared.begin());
+        }
+        wide.assign(2 * n, 0);
+        product.assign(2 * n + 2, 0);
+        quotient.assign(2 * n + 2, 0);
+        remainder.assign(n + 1, 0);
+        left.assign(n, 0);
+        right.assign(n, 0);
+        accumulator.assign(n, 0);
+    }
+    /**
+     * @brief Copies the context onto the resource of other.
+     */
+    bigint_modulus(const bigint_modulus &other)
+        : m(other.m, other.resource()), n(other.n), mu(other.mu, other.resource()), montgomery(other.montgomery),
+          mInv(other.mInv), rSquared(other.rSquared, other.resource()), wide(other.wide, other.resource()),
+          product(other.product, other.resource()), quotient(other.quotient, other.resource()),
+          remainder(other.remainder, other.resource()), table(other.table, other.resource()),
+          left(other.left, other.resource()), right(other.right, other.resource()),
+          accumulator(other.accumulator, other.resource()) {}
+    bigint_modulus &operator=(const bigint_modulus &other) = default;
+
+    /**
+     * @brief Returns the memory resource the context allocates from.
+     */
+    std::pmr::memory_resource *resource() const {
+        return m.resource();
+    }
+
+    /**
+     * @brief Returns the modulus.
+     */
+    const bigint &modulus() const {
+        return m;
+    }
+    /**
+     * @brief Reduces x into [0, m), also for negative or oversized x.
+     */
+    bigint reduce(const bigint &x) {
+        bigint_detail::recordOp(bigint_op::reduce, x.limbs.size());
+        reduceInto(accumulator.data(), x);
+        return fromLimbs(accumulator.data());
+    }
+    /**
+     * @brief Computes a * b mod m.
+     */
+    bigint mulmod(const bigint &a, const bigint &b) {
+        bigint_detail::recordOp(bigint_op::mulmod, n);
+        reduceInto(left.data(), a);
+        reduceInto(right.data(), b);
+        mulBarrett(accumulator.data(), left.data(), right.data());
+        return fromLimbs(accumulator.data());
+    }
+    /**
+     * @brief Computes base^exponent mod m with a sliding window.
+     * @param base Any integer; it is reduced first.
+     * @param exponent A non-negative exponent.
+     * @return The result in [0, m).
+     */
+    bigint powmod(const bigint &base, const bigint &exponent) {
+        bigint_detail::recordOp(bigint_op::powmod, n);
+        if (exponent.negative) {
+            throw std::domain_error("Negative exponent");
+        }
+        if (n == 1 && m.limbs[0] == 1) {
+            return bigint();
+        }
+        bool mont = montgomery && n < bigint_tuning::montgomeryThreshold;
+        limb *acc = accumulator.data();
+        limb *x = left.data();
+        reduceInto(x, base);
+        if (mont) {
+            mulMontgomery(x, x, rSquared.data());
+        }
+        size_t bits = bitLength(exponent);
+        if (bits == 0) {
+            return bigint(1);
+        }
+        unsigned window = bits > 671 ? 6 : bits > 239 ? 5 : bits > 79 ? 4 : bits > 23 ? 3 : bits > 6 ? 2 : 1;
+
+        // table holds x^1, x^3, ..., x^(2^window - 1).
+        size_t entries = size_t{1} << (window - 1);
+        table.assign(entries * n, 0);
+        std::copy(x, x + n, table.begin());
+        if (entries > 1) {
+            limb *square = right.data();
+            multiply(mont, square, x, x);
+            for (size_t i = 1; i < entries; ++i) {
+                multiply(mont, &table[i * n], &table[(i - 1) * n], square);
+            }
+        }
+
+        bool started = false;
+        size_t i = bits;
+        while (i > 0) {
+            if (!testBit(exponent, i - 1)) {
+                if (started) {
+                    multiply(mont, acc, acc, acc);
+                }
+                --i;
+                continue;
+            }
+            // Longest window of at most `window` bits ending in a set bit.
+            size_t low = i > window ? i - window : 0;
+            while (!testBit(exponent, low)) {
+                ++low;
+            }
+            size_t value = 0;
+            for (size_t j = i; j > low; --j) {
+                value = value << 1 | (testBit(exponent, j - 1) ? 1 : 0);
+            }
+            const limb *power = &table[(value >> 1) * n];
+            if (started) {
+                for (size_t j = low; j < i; ++j) {
+                    multiply(mont, acc, acc, acc);
+                }
+                multiply(mont, acc, acc, power);
+            } else {
+                std::copy(power, power + n, acc);
+                started = true;
+            }
+            i = low;
+        }
+        if (mont) {
+            std::fill(x, x + n, limb{0});
+            x[0] = 1;
+            mulMontgomery(acc, acc, x);
+        }
+        return fromLimbs(acc);
+    }
+
+private:
+    bigint m;
+    /// Number of limbs in m.
+    size_t n;
+    /// floor(B^(2n) / m), the Barrett reciprocal.
+    bigint mu;
+    /// Whether m is odd, so Montgomery form is available.
+    bool montgomery;
+    /// -m^-1 mod 2^64.
+    limb mInv;
+    /// R^2 mod m with R = B^n, used to enter Montgomery form.
+    bigint_detail::limbBuffer rSquared;
+    /// Scratch buffers reused by every call.
+    bigint_detail::limbBuffer wide;
+    bigint_detail::limbBuffer product;
+    bigint_detail::limbBuffer quotient;
+    bigint_detail::limbBuffer remainder;
+    bigint_detail::limbBuffer table;
+    /// The reduced operands and the accumulator of the current call.
+    bigint_detail::limbBuffer left;
+    bigint_detail::limbBuffer right;
+    bigint_detail::limbBuffer accumulator;
+
+    static size_t bitLength(const bigint &x) {
+        if (x.limbs.empty()) {
+            return 0;
+        }
+        return 64 * x.limbs.size() - static_cast<size_t>(__builtin_clzll(x.limbs.back()));
+    }
+    static bool testBit(const bigint &x, size_t bit) {
+        return (x.limbs[bit / 64] >> (bit % 64) & 1) != 0;
+    }
+    bigint fromLimbs(const limb *r) const {
+        bigint res;
+        res.limbs.assign(r, r + n);
+        res.removeZeros();
+        return res;
+    }
+    /**
+     * @brief Writes x mod m into r as n limbs.
+     */
+    void reduceInto(limb *r, const bigint &x) {
+        if (!x.negative && x.limbs.size() <= 2 * n) {
+            reduceBarrett(r, x.limbs.data(), x.limbs.size());
+            return;
+        }
+        bigint rem = x % m;
+        if (rem.negative) {
+            rem += m;
+        }
+        std::fill(r, r + n, limb{0});
+        std::copy(rem.limbs.begin(), rem.limbs.end(), r);
+    }
+    /**
+     * @brief Barrett reduction of an xn-limb x < B^(2n) into n limbs (HAC 14.42).
+     */
+    void reduceBarrett(limb *r, const limb *x, size_t xn) {
+        using namespace bigint_detail;
+        while (xn > 0 && x[xn - 1] == 0) {
+            --xn;
+        }
+        limb *t = remainder.data();
+        std::fill(t, t + n + 1, limb{0});
+        std::copy(x, x + std::min(xn, n + 1), t);
+        size_t q1n = xn >= n ? xn - (n - 1) : 0;
+        size_t qn = q1n + mu.limbs.size();
+        if (q1n > 0 && qn > n + 1) {
+            // q = floor(floor(x / B^(n-1)) * mu / B^(n+1)) undershoots x / m by at most 2,
+            // so x - q m < 3m < B^(n+1) can be formed modulo B^(n+1).
+            limb *q = quotient.data();
+            mulLimbs(q, x + (n - 1), q1n, mu.limbs.data(), mu.limbs.size());
+            limb *p = product.data();
+            mulLimbs(p, q + (n + 1), qn - (n + 1), m.limbs.data(), n);
+            subNGeneric(t, t, p, n + 1, 0);
+        }
+        while (compareLimbs(t, t[n] != 0 ? n + 1 : n, m.limbs.data(), n) >= 0) {
+            subLimbs(t, t, t[n] != 0 ? n + 1 : n, m.limbs.data(), n);
+        }
+        std::copy(t, t + n, r);
+    }
+    /**
+     * @brief r = a * b mod m for reduced n-limb a and b; r may alias either.
      */
-    friend std::ostream &operator<<(std::ostream &out, const bigint &num){
-        if (num.negative) {
-            out << '-';
+    void mulBarrett(limb *r, const limb *a, const limb *b) {
+        bigint_detail::mulLimbs(wide.data(), a, n, b, n);
+        reduceBarrett(r, wide.data(), 2 * n);
+    }
+    /**
+     * @brief r = a * b / R mod m for n-limb Montgomery residues; r may alias either.
+     */
+    void mulMontgomery(limb *r, const limb *a, const limb *b) {
+        using namespace bigint_detail;
+        limb *t = product.data();
+        mulLimbs(t, a, n, b, n);
+        t[2 * n] = 0;
+        for (size_t i = 0; i < n; ++i) {
+            limb carry = addMulLimb(t + i, m.limbs.data(), n, t[i] * mInv);
+            for (size_t k = i + n; carry != 0; ++k) {
+                limb s = t[k] + carry;
+                carry = s < carry;
+                t[k] = s;
+            }
+        }
+        limb *high = t + n;
+        if (high[n] != 0 || compareLimbs(high, n, m.limbs.data(), n) >= 0) {
+            subNGeneric(high, high, m.limbs.data(), n, 0);
+        }
+        std::copy(high, high + n, r);
+    }
+    void multiply(bool mont, limb *r, const limb *a, const limb *b) {
+        if (mont) {
+            mulMontgomery(r, a, b);
+        } else {
+            mulBarrett(r, a, b);
+        }
+    }
+};
+
+/**
+ * @brief Multiplies all values of a range with a balanced product tree.
+ *
+ * Operands of similar size are paired, so long lists reach Karatsuba, Toom-3
+ * and NTT instead of growing one factor at a time; independent subtrees run
+ * in parallel when bigint_tuning::threads is above 1.
+ * @param values Any range of bigints; an empty range gives 1.
+ * @return The product.
+ */
+template <class Range>
+bigint product(const Range &values) {
+    std::vector<const bigint *> pointers;
+    for (const bigint &value : values) {
+        pointers.push_back(&value);
+    }
+    return bigint::productTree(pointers.data(), pointers.size());
+}
+
+/**
+ * @brief Computes n! by the prime swing algorithm.
+ *
+ * The odd part is built from prime powers with product trees, and the
+ * n - popcount(n) factors of two are applied as one shift at the end.
+ */
+inline bigint factorial(uint64_t n) {
+    bigint res = bigint::oddFactorial(n, bigint_detail::primesUpTo(n));
+    return bigint::shiftBits(res, n - static_cast<uint64_t>(std::popcount(n)), true);
+}
+
+/**
+ * @brief Computes the binomial coefficient n choose k; 0 when k > n.
+ *
+ * For k close to n / 2 the result is assembled from its prime factorization
+ * (Kummer: the exponent of p counts the borrows of n - k in base p). For
+ * small k it is the product n (n - 1) ... (n - k + 1) divided exactly by k!,
+ * which avoids sieving up to a huge n.
+ */
+inline bigint binomial(uint64_t n, uint64_t k) {
+    if (k > n) {
+        return bigint();
+    }
+    k = std::min(k, n - k);
+    std::vector<uint64_t> factors;
+    if (k <= n / 64) {
+        for (uint64_t i = 0; i < k; ++i) {
+            factors.push_back(n - i);
+        }
+        return bigint::productOfWords(factors) / factorial(k);
+    }
+    for (uint64_t p : bigint_detail::primesUpTo(n)) {
+        uint64_t nq = n, kq = k, rq = n - k;
+        while (nq >= p) {
+            nq /= p;
+            kq /= p;
+            rq /= p;
+            for (uint64_t e = nq - kq - rq; e > 0; --e) {
+                factors.push_back(p);
+            }
+        }
+    }
+    return bigint::productOfWords(factors);
+}
+
+/**
+ * @brief Computes the product of all primes up to and including n.
+ */
+inline bigint primorial(uint64_t n) {
+    return bigint::productOfWords(bigint_detail::primesUpTo(n));
+}
+
+/**
+ * @brief Writes a sequence of bigints in the file format read by read_bigints() and bigint_file_view.
+ *
+ * Layout, all little-endian 64-bit words: the magic "BIGINT01", the count,
+ * one byte offset per value (from the start of the file), then the
+ * write_binary() records. Every record starts 8-byte aligned, so a mapped
+ * file can be read in place.
+ * @param out The stream to write to.
+ * @param values Any range of bigints; it is traversed twice.
+ */
+template <class Range>
+void write_bigints(std::ostream &out, const Range &values) {
+    using bigint_detail::limb;
+    using bigint_detail::littleEndian;
+    std::vector<limb> header;
+    header.push_back(0);
+    header.push_back(0);
+    limb offset = 0;
+    for (const bigint &value : values) {
+        header.push_back(offset);
+        offset += value.binary_size();
+    }
+    size_t count = header.size() - 2;
+    limb start = header.size() * sizeof(limb);
+    for (size_t i = 2; i < header.size(); ++i) {
+        header[i] = littleEndian(header[i] + start);
+    }
+    std::copy(std::begin(bigint_detail::FILE_MAGIC), std::end(bigint_detail::FILE_MAGIC),
+              reinterpret_cast<char *>(header.data()));
+    header[1] = littleEndian(count);
+    out.write(reinterpret_cast<const char *>(header.data()), static_cast<std::streamsize>(start));
+    for (const bigint &value : values) {
+        value.write_binary(out);
+    }
+}
+
+/**
+ * @brief Reads every bigint of a file written by write_bigints().
+ * @param in The stream to read from, positioned at the magic.
+ * @return The values in file order.
+ * @throws std::invalid_argument if the data is truncated or malformed.
+ */
+inline std::vector<bigint> read_bigints(std::istream &in) {
+    using bigint_detail::limb;
+    limb header[2];
+    if (!in.read(reinterpret_cast<char *>(header), sizeof(header))) {
+        throw std::invalid_argument("Truncated bigint file");
+    }
+    if (!std::equal(std::begin(bigint_detail::FILE_MAGIC), std::end(bigint_detail::FILE_MAGIC),
+                    reinterpret_cast<const char *>(header))) {
+        throw std::invalid_argument("Not a bigint file");
+    }
+    limb count = bigint_detail::littleEndian(header[1]);
+    limb expected = (count + 2) * sizeof(limb);
+    std::vector<limb> offsets;
+    std::vector<bigint> res;
+    for (limb i = 0; i < count; ++i) {
+        limb offset;
+        if (!in.read(reinterpret_cast<char *>(&offset), sizeof(offset))) {
+            throw std::invalid_argument("Truncated bigint file");
+        }
+        offsets.push_back(bigint_detail::littleEndian(offset));
+    }
+    res.reserve(offsets.size());
+    for (limb offset : offsets) {
+        if (offset != expected) {
+            throw std::invalid_argument("Malformed bigint file");
+        }
+        res.push_back(bigint::read_binary(in));
+        expected += res.back().binary_size();
+    }
+    return res;
+}
+
+/**
+ * @brief A read-only bigint whose limbs live in memory owned by someone else, e.g. a mapped file.
+ *
+ * Nothing is copied or parsed; the view is valid as long as the memory it
+ * points to. Use to_bigint() to compute with the value.
+ */
+class bigint_view {
+public:
+    bigint_view() = default;
+    /**
+     * @brief Views n limbs at data (little-endian, no high zero limb) with the given sign.
+     */
+    bigint_view(const uint64_t *data, size_t n, bool negative) : limbs(data), count(n), sign(negative) {}
+
+    /// Number of limbs; zero for the value 0.
+    size_t size() const { return count; }
+    const uint64_t *data() const { return limbs; }
+    bool is_negative() const { return sign; }
+
+    /**
+     * @brief Copies the value into an owning bigint.
+     */
+    bigint to_bigint() const {
+        bigint res;
+        res.limbs.assign(limbs, limbs + count);
+        res.negative = sign && count > 0;
+        return res;
+    }
+    /**
+     * @brief Compares with a bigint without copying either value.
+     */
+    friend bool operator==(const bigint_view &a, const bigint &b) {
+        return a.equals(b);
+    }
+    friend std::ostream &operator<<(std::ostream &out, const bigint_view &value) {
+        return out << value.to_bigint();
+    }
+
+private:
+    const uint64_t *limbs = nullptr;
+    size_t count = 0;
+    bool sign = false;
+
+    bool equals(const bigint &b) const {
+        return sign == b.negative && count == b.limbs.size() && std::equal(limbs, limbs + count, b.limbs.data());
+    }
+};
+
+/**
+ * @brief Random access to the values of a write_bigints() file held in memory.
+ *
+ * Construction only checks the header; each access checks its own record, so
+ * opening a file costs O(1) however many values it holds. The memory must be
+ * 8-byte aligned (mapped files are page aligned) and outlive the view.
+ */
+class bigint_file_view {
+public:
+    /**
+     * @brief Views bytes bytes at data.
+     * @throws std::invalid_argument if the data is not an aligned bigint file.
+     */
+    bigint_file_view(const void *data, size_t bytes)
+        : words(static_cast<const uint64_t *>(data)), wordCount(bytes / sizeof(uint64_t)) {
+        if constexpr (std::endian::native != std::endian::little) {
+            throw std::logic_error("bigint_file_view needs a little-endian host; use read_bigints()");
+        }
+        if (reinterpret_cast<uintptr_t>(data) % alignof(uint64_t) != 0) {
+            throw std::invalid_argument("Unaligned bigint file");
+        }
+        if (wordCount < 2 || !std::equal(std::begin(bigint_detail::FILE_MAGIC), std::end(bigint_detail::FILE_MAGIC),
+                                         static_cast<const char *>(data))) {
+            throw std::invalid_argument("Not a bigint file");
+        }
+        count = words[1];
+        if (count > wordCount - 2) {
+            throw std::invalid_argument("Truncated bigint file");
+        }
+    }
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    /**
+     * @brief The i-th value, for i < size().
+     * @throws std::invalid_argument if its record lies outside the data or is not canonical.
+     */
+    bigint_view operator[](size_t i) const {
+        uint64_t offset = words[2 + i];
+        if (offset % sizeof(uint64_t) != 0 || offset / sizeof(uint64_t) >= wordCount) {
+            throw std::invalid_argument("Malformed bigint file");
+        }
+        size_t at = offset / sizeof(uint64_t);
+        uint64_t header = words[at];
+        size_t limbs = static_cast<uint32_t>(header);
+        bool negative = (header & bigint_detail::NEGATIVE_FLAG) != 0;
+        if (header >> 33 != 0 || limbs > wordCount - at - 1 || (limbs > 0 && words[at + limbs] == 0)
+            || (limbs == 0 && negative)) {
+            throw std::invalid_argument("Malformed bigint file");
+        }
+        return bigint_view(words + at + 1, limbs, negative);
+    }
+
+private:
+    const uint64_t *words;
+    size_t wordCount;
+    size_t count;
+};
+
+#if BIGINT_HAS_MMAP
+/**
+ * @brief Maps a write_bigints() file read-only and exposes its values as views.
+ *
+ * Pages are loaded by the kernel on first access, so opening a file of
+ * millions of values is immediate. Views must not outlive the mapping.
+ */
+class bigint_mapped_file {
+public:
+    /**
+     * @brief Maps the file at path.
+     * @throws std::system_error if the file cannot be opened or mapped.
+     * @throws std::invalid_argument if it is not a bigint file.
+     */
+    explicit bigint_mapped_file(const std::string &path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::system_error(errno, std::generic_category(), "Cannot open " + path);
+        }
+        struct stat info;
+        if (::fstat(fd, &info) != 0) {
+            int error = errno;
+            ::close(fd);
+            throw std::system_error(error, std::generic_category(), "Cannot stat " + path);
+        }
+        bytes = static_cast<size_t>(info.st_size);
+        if (bytes == 0) {
+            ::close(fd);
+            throw std::invalid_argument("Not a bigint file");
+        }
+        void *mapped = ::mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+        int error = errno;
+        ::close(fd);
+        if (mapped == MAP_FAILED) {
+            throw std::system_error(error, std::generic_category(), "Cannot map " + path);
+        }
+        address = mapped;
+        try {
+            contents.emplace(address, bytes);
+        } catch (...) {
+            ::munmap(address, bytes);
+            throw;
+        }
+    }
+    ~bigint_mapped_file() {
+        if (address != nullptr) {
+            ::munmap(address, bytes);
+        }
+    }
+    bigint_mapped_file(bigint_mapped_file &&other) noexcept
+        : address(std::exchange(other.address, nullptr)), bytes(other.bytes), contents(std::move(other.contents)) {}
+    bigint_mapped_file(const bigint_mapped_file &) = delete;
+    bigint_mapped_file &operator=(const bigint_mapped_file &) = delete;
+
+    const bigint_file_view &view() const { return *contents; }
+    size_t size() const { return contents->size(); }
+    bigint_view operator[](size_t i) const { return (*contents)[i]; }
+
+private:
+    void *address = nullptr;
+    size_t bytes = 0;
+    std::optional<bigint_file_view> contents;
+};
+#endif
+
+/**
+ * @brief Incremental decimal parser that accepts the digits of one number in pieces.
+ *
+ * Digits are buffered only up to one block; each full block is converted and
+ * merged with earlier blocks of the same size through the cached powers of
+ * ten, like a binary counter. Parsing n digits therefore costs O(M(n) log n)
+ * and needs one block of text plus the limbs of the result, however the
+ * input is split.
+ */
+class bigint_parser {
+public:
+    /// Digits per block, 19 * 2^BLOCK_LEVEL, so blocks line up with the cached powers 10^(19 * 2^k).
+    static constexpr size_t BLOCK_LEVEL = 10;
+    static constexpr size_t BLOCK_DIGITS = bigint_detail::DIGITS_PER_LIMB << BLOCK_LEVEL;
+
+    bigint_parser() {
+        pending.reserve(BLOCK_DIGITS);
+    }
+
+    /**
+     * @brief Consumes the next piece of the number; only the first piece may start with '-'.
+     * @param text The characters to consume.
+     * @param len Their count.
+     * @throws std::invalid_argument on a character that is not a digit.
+     */
+    void feed(const char *text, size_t len) {
+        if (len > 0 && !started && text[0] == '-') {
+            negative = true;
+            ++text;
+            --len;
+        }
+        started = true;
+        while (len > 0) {
+            size_t take = std::min(len, BLOCK_DIGITS - pending.size());
+            for (size_t i = 0; i < take; ++i) {
+                if (text[i] < '0' || text[i] > '9') {
+                    throw std::invalid_argument("Invalid characters");
+                }
+            }
+            pending.append(text, take);
+            text += take;
+            len -= take;
+            if (pending.size() == BLOCK_DIGITS) {
+                pushBlock();
+            }
+        }
+    }
+    void feed(const std::string &text) {
+        feed(text.data(), text.size());
+    }
+    /**
+     * @brief Number of digits consumed so far, without the sign.
+     */
+    size_t digits() const {
+        return blockDigits + pending.size();
+    }
+    /**
+     * @brief Returns the parsed value and resets the parser for the next number.
+     * @throws std::invalid_argument if no digit was consumed.
+     */
+    bigint finish() {
+        if (digits() == 0) {
+            bool sawSign = negative;
+            reset();
+            throw std::invalid_argument(sawSign ? "Invalid characters" : "Empty string cannot be converted");
+        }
+        bigint_detail::recordOp(bigint_op::parse, digits() / bigint_detail::DIGITS_PER_LIMB + 1);
+        bigint res;
+        for (size_t i = 0; i < blocks.size(); ++i) {
+            if (i == 0) {
+                res = std::move(blocks[i].first);
+            } else {
+                res = res * bigint::decimalPower(blocks[i].second) + blocks[i].first;
+            }
+        }
+        if (!pending.empty()) {
+            bigint tail = bigint::parseDecimal(pending.data(), pending.size());
+            if (blocks.empty()) {
+                res = std::move(tail);
+            } else {
+                std::string scale(pending.size() + 1, '0');
+                scale[0] = '1';
+                res = res * bigint::parseDecimal(scale.data(), scale.size()) + tail;
+            }
+        }
+        res.negative = negative && !res.limbs.empty();
+        reset();
+        return res;
+    }
+
+private:
+    /// Converted blocks, most significant first, each with its level k (19 * 2^k digits); levels strictly decrease.
+    std::vector<std::pair<bigint, size_t>> blocks;
+    std::string pending;
+    size_t blockDigits = 0;
+    bool negative = false;
+    bool started = false;
+
+    void pushBlock() {
+        blocks.emplace_back(bigint::parseDecimal(pending.data(), pending.size()), BLOCK_LEVEL);
+        blockDigits += pending.size();
+        pending.clear();
+        while (blocks.size() >= 2 && blocks[blocks.size() - 2].second == blocks.back().second) {
+            std::pair<bigint, size_t> low = std::move(blocks.back());
+            blocks.pop_back();
+            std::pair<bigint, size_t> &high = blocks.back();
+            high.first = high.first * bigint::decimalPower(low.second) + low.first;
+            ++high.second;
+        }
+    }
+    void reset() {
+        blocks.clear();
+        pending.clear();
+        blockDigits = 0;
+        negative = false;
+        started = false;
+    }
+};
+
+/**
+ * @brief Reads a decimal integer with an optional leading '-' or '+' from a stream.
+ *
+ * Leading whitespace is skipped as for built-in integers and reading stops
+ * at the first non-digit, which stays in the stream. Digits reach a
+ * bigint_parser in fixed-size chunks, so the text is never held in full.
+ * Sets failbit and leaves num unchanged if no digit follows.
+ */
+inline std::istream &operator>>(std::istream &in, bigint &num) {
+    std::istream::sentry sentry(in);
+    if (!sentry) {
+        return in;
+    }
+    std::streambuf *buffer = in.rdbuf();
+    bigint_parser parser;
+    char chunk[4096];
+    size_t used = 0;
+    bool any = false;
+    int c = buffer->sgetc();
+    if (c == '-' || c == '+') {
+        if (c == '-') {
+            chunk[used++] = '-';
+        }
+        c = buffer->snextc();
+    }
+    while (c >= '0' && c <= '9') {
+        any = true;
+        chunk[used++] = static_cast<char>(c);
+        if (used == sizeof(chunk)) {
+            parser.feed(chunk, used);
+            used = 0;
+        }
+        c = buffer->snextc();
+    }
+    std::ios_base::iostate state = std::ios_base::goodbit;
+    if (c == std::char_traits<char>::eof()) {
+        state |= std::ios_base::eofbit;
+    }
+    if (any) {
+        parser.feed(chunk, used);
+        num = parser.finish();
+    } else {
+        state |= std::ios_base::failbit;
+    }
+    in.setstate(state);
+    return in;
+}
+
+/**
+ * @brief Whether n, which has more than one limb, is divisible by a prime below limit.
+ */
+inline bool bigint::hasSmallFactor(const bigint &n, uint64_t limit) {
+    const std::vector<uint64_t> &primes = bigint_detail::smallPrimes();
+    for (const bigint_detail::primeGroup &group : bigint_detail::smallPrimeGroups()) {
+        if (primes[group.first] >= limit) {
+            break;
+        }
+        limb r = bigint_detail::divLimb(nullptr, n.limbs.data(), n.limbs.size(), group.product);
+        for (size_t i = group.first; i < group.first + group.count; ++i) {
+            if (r % primes[i] == 0) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Strong probable prime test of odd n > 3 to the given base.
+ */
+inline bool bigint::millerRabin(const bigint &n, bigint_modulus &mod, const bigint &base) {
+    bigint nMinus1 = n - 1;
+    size_t s = 0;
+    while (nMinus1.limbs[s / 64] == 0) {
+        s += 64;
+    }
+    s += static_cast<size_t>(std::countr_zero(nMinus1.limbs[s / 64]));
+    bigint x = mod.powmod(base, shiftBits(nMinus1, s, false));
+    if (x == 1 || x == nMinus1) {
+        return true;
+    }
+    for (size_t r = 1; r < s; ++r) {
+        x = mod.mulmod(x, x);
+        if (x == nMinus1) {
+            return true;
+        }
+        if (x == 1) {
+            return false;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Strong Lucas probable prime test of odd n with Selfridge's parameters.
+ *
+ * D is the first of 5, -7, 9, -11, ... with Jacobi symbol (D / n) = -1,
+ * P = 1 and Q = (1 - D) / 4. U and V are computed by the binary doubling
+ * formulas on the odd part d of n + 1 = d 2^s.
+ */
+inline bool bigint::strongLucas(const bigint &n, bigint_modulus &mod) {
+    int64_t d = 5;
+    for (int tries = 0;; ++tries) {
+        limb magnitude = wordMagnitude(d);
+        int symbol = bigint_detail::jacobiWord(bigint_detail::divLimb(nullptr, n.limbs.data(), n.limbs.size(), magnitude),
+                                               magnitude);
+        // Quadratic reciprocity for odd positive |D|, then the sign of D.
+        if ((magnitude % 4 == 3) && (n.limbs[0] % 4 == 3)) {
+            symbol = -symbol;
+        }
+        if (d < 0 && n.limbs[0] % 4 == 3) {
+            symbol = -symbol;
+        }
+        if (symbol == -1) {
+            break;
+        }
+        if (symbol == 0 && (n.limbs.size() > 1 || n.limbs[0] != magnitude)) {
+            return false;
+        }
+        if (tries == 4 && squareOf(isqrt(n)) == n) {
+            // No D with symbol -1 exists for a perfect square.
+            return false;
+        }
+        d = d > 0 ? -(d + 2) : -d + 2;
+    }
+    int64_t q = (1 - d) / 4;
+    // Brings a value from (-2n, 2n) into [0, n) without a full reduction.
+    auto normalize = [&](bigint &x) {
+        while (x.negative) {
+            x += n;
+        }
+        if (compareMagnitude(x, n) >= 0) {
+            x -= n;
+        }
+    };
+    auto half = [&](bigint &x) {
+        if (!x.limbs.empty() && (x.limbs[0] & 1) != 0) {
+            x += n;
+        }
+        x = shiftBits(x, 1, false);
+    };
+
+    bigint nPlus1 = n + 1;
+    size_t s = 0;
+    while (nPlus1.limbs[s / 64] == 0) {
+        s += 64;
+    }
+    s += static_cast<size_t>(std::countr_zero(nPlus1.limbs[s / 64]));
+    bigint k = shiftBits(nPlus1, s, false);
+    bigint u = 1, v = 1, qk = mod.reduce(bigint(q));
+    for (size_t i = k.bitLength() - 1; i-- > 0;) {
+        // (U, V, Q^k) for 2k.
+        u = mod.mulmod(u, v);
+        v = mod.mulmod(v, v) - qk - qk;
+        normalize(v);
+        qk = mod.mulmod(qk, qk);
+        if (((k.limbs[i / 64] >> (i % 64)) & 1) != 0) {
+            // (U, V, Q^k) for k + 1 with P = 1.
+            bigint nextU = u + v;
+            normalize(nextU);
+            half(nextU);
+            v = mod.reduce(u * d + v);
+            half(v);
+            u = std::move(nextU);
+            qk = mod.reduce(qk * q);
+        }
+    }
+    if (u.limbs.empty() || v.limbs.empty()) {
+        return true;
+    }
+    for (size_t r = 1; r < s; ++r) {
+        v = mod.mulmod(v, v) - qk - qk;
+        normalize(v);
+        if (v.limbs.empty()) {
+            return true;
+        }
+        qk = mod.mulmod(qk, qk);
+    }
+    return false;
+}
+
+/**
+ * @brief Probabilistic primality test: Baillie-PSW plus optional Miller-Rabin rounds.
+ *
+ * Single-limb values are decided exactly by a deterministic Miller-Rabin
+ * base set. Larger values are trial divided by the primes below
+ * bigint_detail::TRIAL_PRIME_LIMIT, then given a strong base-2 test and a
+ * strong Lucas test; no composite passing both is known. Each extra round
+ * tests a random base and lets at most 1/4 of the composites through.
+ * @param n The value to test; values below 2 are not prime.
+ * @param rounds Extra Miller-Rabin rounds with random bases.
+ * @return False if n is certainly composite, true if it is (probably) prime.
+ */
+inline bool is_probable_prime(const bigint &n, size_t rounds = 0) {
+    if (n.negative || n.limbs.empty()) {
+        return false;
+    }
+    if (n.limbs.size() == 1) {
+        return bigint_detail::isPrimeWord(n.limbs[0]);
+    }
+    if ((n.limbs[0] & 1) == 0 || bigint::hasSmallFactor(n, bigint_detail::TRIAL_PRIME_LIMIT)) {
+        return false;
+    }
+    bigint_modulus mod(n, bigint_detail::currentResource());
+    if (!bigint::millerRabin(n, mod, bigint(2)) || !bigint::strongLucas(n, mod)) {
+        return false;
+    }
+    std::mt19937_64 &rng = bigint_detail::primeRandom();
+    bigint range = n - 3;
+    for (size_t round = 0; round < rounds; ++round) {
+        // A base in [2, n - 2], with a negligible bias from the extra limb.
+        bigint base;
+        base.limbs.resize(n.limbs.size() + 1);
+        for (bigint_detail::limb &word : base.limbs) {
+            word = rng();
+        }
+        base.removeZeros();
+        base = base % range + 2;
+        if (!bigint::millerRabin(n, mod, base)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief The smallest probable prime greater than n.
+ *
+ * Candidates are sieved a window at a time by the primes below
+ * bigint_detail::SIEVE_PRIME_LIMIT, using one single-limb division per group
+ * of primes. The survivors go through is_probable_prime(), several at once
+ * on the thread pool when bigint_tuning::threads is above 1 and the
+ * candidates are large enough; the smallest prime found is returned either way.
+ * @param n Any integer.
+ * @param rounds Extra Miller-Rabin rounds passed to is_probable_prime().
+ */
+inline bigint next_prime(const bigint &n, size_t rounds = 0) {
+    using bigint_detail::limb;
+    if (n < 2) {
+        return bigint(2);
+    }
+    // The largest prime below 2^64.
+    constexpr limb LARGEST_WORD_PRIME = 18446744073709551557ULL;
+    if (n.limbs.size() == 1 && n.limbs[0] < LARGEST_WORD_PRIME) {
+        limb c = n.limbs[0] + 1;
+        c += c > 2 && c % 2 == 0 ? 1 : 0;
+        while (!bigint_detail::isPrimeWord(c)) {
+            c += 2;
+        }
+        bigint res;
+        res.limbs.push_back(c);
+        return res;
+    }
+    bigint start = n + 1;
+    if ((start.limbs[0] & 1) == 0) {
+        start += 1;
+    }
+    size_t bits = start.bitLength();
+    uint64_t limit = std::min<uint64_t>(bigint_detail::SIEVE_PRIME_LIMIT, static_cast<uint64_t>(bits) * bits);
+    // Odd candidates per window: about six average prime gaps.
+    size_t window = std::max<size_t>(256, 2 * bits);
+    const std::vector<uint64_t> &primes = bigint_detail::smallPrimes();
+    bigint_detail::workStealingPool *pool = bigint_detail::parallelPool(bits * start.limbs.size());
+    size_t batch = pool == nullptr ? 1 : bigint_tuning::threads;
+    for (;;) {
+        // composite[i] marks start + 2 i; start exceeds every sieving prime.
+        std::vector<char> composite(window);
+        for (const bigint_detail::primeGroup &group : bigint_detail::smallPrimeGroups()) {
+            if (primes[group.first] >= limit) {
+                break;
+            }
+            limb r = bigint_detail::divLimb(nullptr, start.limbs.data(), start.limbs.size(), group.product);
+            for (size_t i = group.first; i < group.first + group.count; ++i) {
+                uint64_t p = primes[i];
+                if (p == 2) {
+                    continue;
+                }
+                // start + 2 i = 0 (mod p) for i = -r / 2 = (p - r) (p + 1) / 2.
+                uint64_t first = (p - r % p) % p * ((p + 1) / 2) % p;
+                for (size_t j = static_cast<size_t>(first); j < window; j += static_cast<size_t>(p)) {
+                    composite[j] = 1;
+                }
+            }
+        }
+        std::vector<size_t> survivors;
+        for (size_t i = 0; i < window; ++i) {
+            if (composite[i] == 0) {
+                survivors.push_back(i);
+            }
+        }
+        for (size_t k = 0; k < survivors.size(); k += batch) {
+            size_t count = std::min(batch, survivors.size() - k);
+            std::vector<bigint> candidates;
+            for (size_t j = 0; j < count; ++j) {
+                candidates.push_back(start + static_cast<int64_t>(2 * survivors[k + j]));
+            }
+            std::vector<char> prime(count);
+            if (count == 1) {
+                prime[0] = is_probable_prime(candidates[0], rounds);
+            } else {
+                std::vector<std::function<void()>> tasks;
+                for (size_t j = 0; j < count; ++j) {
+                    tasks.emplace_back([&, j] { prime[j] = is_probable_prime(candidates[j], rounds); });
+                }
+                pool->run(tasks.data(), count);
+            }
+            for (size_t j = 0; j < count; ++j) {
+                if (prime[j] != 0) {
+                    return std::move(candidates[j]);
+                }
+            }
+        }
+        start += static_cast<int64_t>(2 * window);
+    }
+}
+
+/**
+ * @brief A random probable prime of exactly bits bits.
+ *
+ * Draws a random bits-bit value with its top bit set and returns the next
+ * prime from there, redrawing when that overflows bits bits. Primes that
+ * follow long gaps are therefore slightly more likely than others.
+ * @param bits The bit length, at least 2.
+ * @param rng A uniform random bit generator, e.g. std::mt19937_64.
+ * @param rounds Extra Miller-Rabin rounds passed to is_probable_prime().
+ * @throws std::domain_error if bits is below 2.
+ */
+template <class Rng>
+bigint random_prime(size_t bits, Rng &rng, size_t rounds = 0) {
+    if (bits < 2) {
+        throw std::domain_error("No prime has fewer than 2 bits");
+    }
+    std::uniform_int_distribution<uint64_t> word;
+    size_t count = (bits + 63) / 64;
+    unsigned topBits = static_cast<unsigned>(bits - 64 * (count - 1));
+    std::vector<uint64_t> words(count);
+    bigint bound = pow(bigint(2), bits);
+    for (;;) {
+        for (uint64_t &w : words) {
+            w = word(rng);
+        }
+        uint64_t top = uint64_t{1} << (topBits - 1);
+        words.back() = (words.back() & (top | (top - 1))) | top;
+        bigint p = next_prime(bigint_view(words.data(), count, false).to_bigint() - 1, rounds);
+        if (p < bound) {
+            return p;
+        }
+    }
+}
+
+/**
+ * @brief A random probable prime of exactly bits bits from a per-thread generator seeded by std::random_device.
+ */
+inline bigint random_prime(size_t bits) {
+    return random_prime(bits, bigint_detail::primeRandom());
+}
+
+namespace bigint_detail {
+
+/**
+ * @brief Parses an integer literal (decimal, 0x hex, 0b binary or 0 octal, with ' separators) into n limbs.
+ * @throws std::invalid_argument on a digit outside the radix; in a constant expression this is a compile error.
+ */
+template <size_t N>
+constexpr std::array<limb, N> parseLiteral(const char *text, size_t len) {
+    limb radix = 10;
+    size_t i = 0;
+    if (len > 1 && text[0] == '0') {
+        if (text[1] == 'x' || text[1] == 'X') {
+            radix = 16;
+            i = 2;
+        } else if (text[1] == 'b' || text[1] == 'B') {
+            radix = 2;
+            i = 2;
+        } else {
+            radix = 8;
+            i = 1;
         }
-        out << num.number;
-        return out;
     }
-private:
-    std::string number;
-    bool negative;
-     /**
-     * @brief Removes leading zeros from the number string.
-     */
-    void removeZeros(){
-        while(number.size() > 1 && number[0] == '0'){
-            number.erase(0, 1);
+    std::array<limb, N> value{};
+    for (; i < len; ++i) {
+        char c = text[i];
+        if (c == '\'') {
+            continue;
+        }
+        limb digit = radix;
+        if (c >= '0' && c <= '9') {
+            digit = static_cast<limb>(c - '0');
+        } else if (c >= 'a' && c <= 'f') {
+            digit = static_cast<limb>(c - 'a' + 10);
+        } else if (c >= 'A' && c <= 'F') {
+            digit = static_cast<limb>(c - 'A' + 10);
+        }
+        if (digit >= radix) {
+            throw std::invalid_argument("Invalid characters");
+        }
+        limb carry = digit;
+        for (limb &word : value) {
+            dlimb t = static_cast<dlimb>(word) * radix + carry;
+            word = static_cast<limb>(t);
+            carry = static_cast<limb>(t >> 64);
         }
     }
-     /**
-     * @brief Validates that a string contains only numeric digits.
-     * @param str The string to validate.
-     * @param startIndex The starting index to check from.
-     * @return True if the string contains only digits, otherwise false.
-     */
-     bool isValidNumber(const std::string &str, size_t startIndex) const {
-        for (size_t i = startIndex; i < str.size(); ++i) {
-            if (str[i] < '0' || str[i] > '9') {
-                return false;
-            }
+    return value;
+}
+
+/**
+ * @brief Number of significant bits in a little-endian limb array.
+ */
+template <size_t N>
+constexpr size_t literalBitWidth(const std::array<limb, N> &value) {
+    for (size_t i = N; i-- > 0;) {
+        if (value[i] != 0) {
+            return i * 64 + static_cast<size_t>(std::bit_width(value[i]));
         }
-        return true;
     }
+    return 0;
+}
+
+} // namespace bigint_detail
 
+/**
+ * @brief A fixed-width integer of Bits bits with inline storage and constexpr arithmetic.
+ *
+ * Meant for values of known, bounded width (hashes, keys, accumulators)
+ * where bigint's dynamic size is pure overhead. Signed values are two's
+ * complement; like unsigned built-ins, every operation wraps modulo 2^Bits.
+ * Division truncates toward zero. Converts losslessly to bigint, and from
+ * bigint when the value fits.
+ * @tparam Bits The width, a positive multiple of 64.
+ * @tparam Signed Whether the top bit is a sign bit; see wide_uint for the unsigned form.
+ */
+template <size_t Bits, bool Signed = true>
+class wide_int {
+    static_assert(Bits > 0 && Bits % 64 == 0, "wide_int width must be a positive multiple of 64");
 public:
+    using limb = bigint_detail::limb;
+    /// Number of 64-bit limbs.
+    static constexpr size_t LIMBS = Bits / 64;
+    using limb_array = std::array<limb, LIMBS>;
+
+    constexpr wide_int() = default;
     /**
-     * @brief Default constructor.
+     * @brief Converts a built-in integer, sign-extending negative values.
      */
-    bigint(): number("0"), negative(false) {}
-     /**
-     * @brief Constructor that takes 64-bit integer.
-     * @param num The integer to initialize the bigint.
+    constexpr wide_int(int64_t value) {
+        words[0] = static_cast<limb>(value);
+        for (size_t i = 1; i < LIMBS; ++i) {
+            words[i] = value < 0 ? ~limb{0} : 0;
+        }
+    }
+    /**
+     * @brief Takes the raw little-endian two's complement limbs.
      */
-    bigint(const int64_t num){
-        if (num < 0) {
-            negative = true;
-            number = std::to_string(-num);
-        } else {
-            negative = false;
-            number = std::to_string(num);
+    constexpr explicit wide_int(const limb_array &limbs) : words(limbs) {}
+    /**
+     * @brief Converts another width or signedness, truncating or extending as a cast of built-ins would.
+     */
+    template <size_t OtherBits, bool OtherSigned>
+    constexpr explicit wide_int(const wide_int<OtherBits, OtherSigned> &other) {
+        const auto &source = other.limbs();
+        limb fill = other.is_negative() ? ~limb{0} : 0;
+        for (size_t i = 0; i < LIMBS; ++i) {
+            words[i] = i < source.size() ? source[i] : fill;
         }
-       
     }
-     /**
-     * @brief Constructor that takes a string.
-     * @param num A string representing a number.
+    /**
+     * @brief Converts a bigint.
+     * @throws std::range_error if the value does not fit.
      */
-    bigint(const std::string &num) {
-        if (num.empty()) {
-            throw std::invalid_argument("Empty string cannot be converted");
+    explicit wide_int(const bigint &value) {
+        const bigint_detail::limbVector &mag = value.limbs;
+        bool fits = mag.size() <= LIMBS && (!value.negative || Signed);
+        if (fits && mag.size() == LIMBS && Signed) {
+            // The magnitude may use the sign bit only as the minimum value -2^(Bits - 1).
+            limb top = mag[LIMBS - 1];
+            bool minimum = value.negative && top == limb{1} << 63
+                           && std::all_of(mag.data(), mag.data() + LIMBS - 1, [](limb w) { return w == 0; });
+            fits = (top >> 63) == 0 || minimum;
         }
-
-        size_t startIndex = 0;
-        if (num[0] == '-') {
-            negative = true;
-            startIndex = 1;
-        } else {
-            negative = false;
+        if (!fits) {
+            throw std::range_error("bigint does not fit in wide_int");
         }
-
-        if (!isValidNumber(num, startIndex)) {
-            throw std::invalid_argument("Invalid characters");
+        std::copy(mag.data(), mag.data() + mag.size(), words.begin());
+        if (value.negative) {
+            *this = -*this;
         }
-
-        number = num.substr(startIndex);
-        removeZeros();
     }
+
     /**
-     * @brief Overloaded addition operator.
-     * @param num The bigint to add.
-     * @return A new bigint.
+     * @brief Converts to a bigint; never loses information.
      */
-    bigint operator+(const bigint &num) const{
-      if(negative == num.negative){
-        std::string sum;
-        int64_t next = 0;
-        size_t numberSize = number.size() ;
-        size_t numSize = num.number.size();
-        int64_t num1 = 0;
-        int64_t num2 = 0;
-        while(numberSize > 0 || numSize > 0 || next > 0) {
-          if(numberSize > 0){
-            --numberSize;
-            num1 = number[numberSize] - '0';
-          } else {
-            num1 = 0;
-          }
-          if(numSize > 0){
-            --numSize;
-            num2 = num.number[numSize] - '0';
-          
-          } else {
-            num2 = 0;
-          }
-          int64_t plus = num1 + num2 + next;
-          next = plus / 10;
-          sum += std::to_string(plus % 10);
-        }
-
-        std::reverse(sum.begin(), sum.end());
-        bigint resultSum;
-        resultSum.number = sum;
-        resultSum.negative = negative;
-        resultSum.removeZeros();
-        if(resultSum.number == "0") {
-              resultSum.negative = false;
-        }
-        return resultSum;
-      }else if(negative){
-        return num - (-*this);
-      }else{
-        return *this - (-num);
-      }
+    bigint to_bigint() const {
+        bool neg = is_negative();
+        limb_array mag = neg ? (-*this).words : words;
+        bigint res;
+        res.limbs.assign(mag.data(), mag.data() + LIMBS);
+        res.negative = neg;
+        res.removeZeros();
+        return res;
+    }
+    operator bigint() const {
+        return to_bigint();
+    }
 
+    /// The raw little-endian two's complement limbs.
+    constexpr const limb_array &limbs() const { return words; }
+    constexpr bool is_negative() const {
+        return Signed && (words[LIMBS - 1] >> 63) != 0;
     }
-      /**
-     * @brief Overloaded addition assignment operator.
-     * @param num The bigint to add.
-     * @return A reference to the current bigint.
-     */
-    bigint& operator+=(const bigint &num){
-        *this = *this + num;
-        return *this;
+    constexpr explicit operator bool() const {
+        return *this != wide_int();
+    }
+
+    friend constexpr wide_int operator+(const wide_int &a, const wide_int &b) {
+        wide_int res;
+        addLimbs(res.words, a.words, b.words, std::make_index_sequence<LIMBS>());
+        return res;
+    }
+    friend constexpr wide_int operator-(const wide_int &a, const wide_int &b) {
+        wide_int res;
+        subLimbs(res.words, a.words, b.words, std::make_index_sequence<LIMBS>());
+        return res;
     }
     /**
-     * @brief Overloaded subtraction operator.
-     * @param num The bigint to subtract.
-     * @return A new bigint.
+     * @brief Low Bits bits of the product; only the limb pairs below the width are multiplied.
      */
-    bigint operator-(const bigint &num) const{
-        if(number == num.number && negative == num.negative){
-            return bigint("0");
-        }
-        if(negative != num.negative){
-            return *this + (-num);
-        }
-        bigint larger = *this;
-        bigint smaller = num;
-        int64_t before = 0;
-        bool resultNegative = negative;
-        if(*this < num){
-            larger = num;
-            smaller = *this;
-            resultNegative = true;
-        }else{
-            resultNegative = false;
-        }
-        std::string difference;
-        size_t largerSize = larger.number.size();
-        size_t smallerSize = smaller.number.size();
-        while(largerSize > 0 || smallerSize > 0 || before > 0){
-            int64_t num1 = 0;
-            int64_t num2 = 0;
-            if(largerSize > 0){
-                --largerSize;
-                num1 = larger.number[largerSize] - '0';
-            } else {
-                num1 = 0;
-            }
-            if(smallerSize > 0){
-                --smallerSize;
-                num2 = smaller.number[smallerSize] - '0';
-            } else {
-                num2 = 0;
-            }
-            int64_t minus = num1 - num2 - before;
-            if(minus < 0){
-                minus += 10;
-                before = 1;
-            } else {
-                before = 0;
+    friend constexpr wide_int operator*(const wide_int &a, const wide_int &b) {
+        wide_int res;
+        for (size_t i = 0; i < LIMBS; ++i) {
+            limb carry = 0;
+            for (size_t j = 0; i + j < LIMBS; ++j) {
+                bigint_detail::dlimb t = static_cast<bigint_detail::dlimb>(a.words[i]) * b.words[j]
+                                         + res.words[i + j] + carry;
+                res.words[i + j] = static_cast<limb>(t);
+                carry = static_cast<limb>(t >> 64);
             }
-            difference += std::to_string(minus);
-        }
-
-        std::reverse(difference.begin(), difference.end());
-
-        bigint resultDifference;
-        resultDifference.number = difference;
-        resultDifference.negative = resultNegative;
-        resultDifference.removeZeros();
-        if (resultDifference.number == "0") {
-            resultDifference.negative = false;
         }
-
-
-        return resultDifference;
+        return res;
     }
-     /**
-     * @brief Overloaded subtraction assignment operator.
-     * @param num The bigint to subtract.
-     * @return A reference to the current bigint after subtraction.
+    /**
+     * @throws std::domain_error if b is zero.
      */
-    bigint operator-=(const bigint &num){
-        *this = *this - num;
-        return *this;
+    friend constexpr wide_int operator/(const wide_int &a, const wide_int &b) {
+        return divmod(a, b).first;
     }
-     /**
-     * @brief Overloaded multiplication operator.
-     * @param num The bigint to multiply with.
-     * @return A new bigint.
+    /**
+     * @brief Remainder with the sign of a.
+     * @throws std::domain_error if b is zero.
      */
-    bigint operator*(const bigint &num) const{
-        if(number == "0" || num.number == "0"){
-            return bigint("0");
+    friend constexpr wide_int operator%(const wide_int &a, const wide_int &b) {
+        return divmod(a, b).second;
+    }
+    friend constexpr wide_int operator&(const wide_int &a, const wide_int &b) {
+        wide_int res;
+        for (size_t i = 0; i < LIMBS; ++i) {
+            res.words[i] = a.words[i] & b.words[i];
         }
-        size_t size = number.size() + num.number.size();
-        std::string res(size, '0');
-
-        for(std::size_t i = number.size(); i > 0; --i){
-            int64_t next = 0;
-            for(std::size_t j = num.number.size(); j > 0; --j){
-                int64_t mul = (number[i-1] - '0') * (num.number[j-1] - '0') + (res[i + j - 1] - '0') + next;
-                res[i + j - 1] = mul % 10 + '0';
-                next = mul / 10;
-            }
-            res[i-1] += next;
-            }
-            while(res.size() > 1 && res[0] == '0'){
-                res.erase(0, 1);
-            }
-            bigint resultMul;
-            resultMul.number = res;
-            if(negative != num.negative){
-                resultMul.negative = true;
-            } else {
-                resultMul.negative = false;
-            }
-            return resultMul;
+        return res;
     }
-    /**
-     * @brief Overloaded multiplication assignment operator.
-     * @param num The bigint to multiply with.
-     * @return A reference to the current bigint after multiplication.
-     */
-    bigint operator*=(const bigint &num){
-        *this = *this * num;
-        return *this;
+    friend constexpr wide_int operator|(const wide_int &a, const wide_int &b) {
+        wide_int res;
+        for (size_t i = 0; i < LIMBS; ++i) {
+            res.words[i] = a.words[i] | b.words[i];
+        }
+        return res;
     }
-      /**
-     * @brief Unary negation operator.
-     * @return A new bigint representing the negated value.
-     */
-
-    bigint operator-() const{
-        bigint res = *this;
-        if(res.number != "0"){
-            res.negative = !res.negative;
+    friend constexpr wide_int operator^(const wide_int &a, const wide_int &b) {
+        wide_int res;
+        for (size_t i = 0; i < LIMBS; ++i) {
+            res.words[i] = a.words[i] ^ b.words[i];
         }
-        if (res.number == "0") {
-            res.negative = false;
+        return res;
+    }
+    constexpr wide_int operator~() const {
+        wide_int res;
+        for (size_t i = 0; i < LIMBS; ++i) {
+            res.words[i] = ~words[i];
         }
         return res;
     }
+    constexpr wide_int operator-() const {
+        return wide_int() - *this;
+    }
+    constexpr wide_int operator+() const {
+        return *this;
+    }
     /**
-     * @brief Overloaded equality comparison operator.
-     * @param num The bigint to compare with.
-     * @return True if both bigints are equal, otherwise false.
+     * @brief Shifts left by n bits; n >= Bits gives zero.
      */
-
-    bool operator==(const bigint &num) const{
-        if(number == num.number && negative == num.negative){
-            return true;
-        }else{
-            return false;
+    constexpr wide_int operator<<(size_t n) const {
+        wide_int res;
+        if (n >= Bits) {
+            return res;
         }
-    }
-      /**
-     * @brief Overloaded inequality comparison operator.
-     * @param num The bigint to compare with.
-     * @return True if both bigints are not equal.
-     */
-    bool operator!=(const bigint &num) const{
-        if(*this==num){
-            return false;
-        }else{
-            return true;
+        size_t offset = n / 64;
+        unsigned bits = static_cast<unsigned>(n % 64);
+        for (size_t i = LIMBS; i-- > offset;) {
+            limb w = words[i - offset] << bits;
+            if (bits != 0 && i > offset) {
+                w |= words[i - offset - 1] >> (64 - bits);
+            }
+            res.words[i] = w;
         }
+        return res;
     }
-     /**
-     * @brief Overloaded less-than comparison operator.
-     * @param num The bigint to compare with.
-     * @return True if the current bigint is less than the other.
+    /**
+     * @brief Shifts right by n bits, arithmetically for signed values (rounding toward minus infinity).
      */
-    bool operator<(const bigint &num) const {
-        if (negative && !num.negative) {
-            return true;
-        } else if (!negative && num.negative) {
-            return false;
+    constexpr wide_int operator>>(size_t n) const {
+        limb fill = is_negative() ? ~limb{0} : 0;
+        wide_int res;
+        for (size_t i = 0; i < LIMBS; ++i) {
+            res.words[i] = fill;
         }
-
-        bool resultNegative = negative;
-
-        if (number.size() != num.number.size()) {
-            if (resultNegative) {
-                if (number.size()>num.number.size()) {
-                    return true;
-                } else {
-                    return false;
-                }
-            } else {
-                if (number.size() < num.number.size()) {
-                    return true;
-                } else {
-                    return false;
-                }
+        if (n >= Bits) {
+            return res;
+        }
+        size_t offset = n / 64;
+        unsigned bits = static_cast<unsigned>(n % 64);
+        for (size_t i = 0; i + offset < LIMBS; ++i) {
+            limb w = words[i + offset] >> bits;
+            if (bits != 0) {
+                limb above = i + offset + 1 < LIMBS ? words[i + offset + 1] : fill;
+                w |= above << (64 - bits);
             }
+            res.words[i] = w;
         }
+        return res;
+    }
 
-        for (std::size_t i = 0; i < number.size(); ++i) {
-            if (number[i] != num.number[i]) {
-                if (resultNegative) {
-                    if(number[i] > num.number[i]){
-                        return true;
-                    } else {
-                        return false;
-                    }
-                } else {
-                    if (number[i] < num.number[i]) {
-                        return true;
-                    } else {
-                        return false;
-                    }
-                }
+    constexpr wide_int &operator+=(const wide_int &b) { return *this = *this + b; }
+    constexpr wide_int &operator-=(const wide_int &b) { return *this = *this - b; }
+    constexpr wide_int &operator*=(const wide_int &b) { return *this = *this * b; }
+    constexpr wide_int &operator/=(const wide_int &b) { return *this = *this / b; }
+    constexpr wide_int &operator%=(const wide_int &b) { return *this = *this % b; }
+    constexpr wide_int &operator&=(const wide_int &b) { return *this = *this & b; }
+    constexpr wide_int &operator|=(const wide_int &b) { return *this = *this | b; }
+    constexpr wide_int &operator^=(const wide_int &b) { return *this = *this ^ b; }
+    constexpr wide_int &operator<<=(size_t n) { return *this = *this << n; }
+    constexpr wide_int &operator>>=(size_t n) { return *this = *this >> n; }
+    constexpr wide_int &operator++() { return *this += 1; }
+    constexpr wide_int &operator--() { return *this -= 1; }
+    constexpr wide_int operator++(int) {
+        wide_int old = *this;
+        *this += 1;
+        return old;
+    }
+    constexpr wide_int operator--(int) {
+        wide_int old = *this;
+        *this -= 1;
+        return old;
+    }
+
+    friend constexpr bool operator==(const wide_int &a, const wide_int &b) {
+        return a.words == b.words;
+    }
+    friend constexpr bool operator!=(const wide_int &a, const wide_int &b) {
+        return !(a == b);
+    }
+    friend constexpr bool operator<(const wide_int &a, const wide_int &b) {
+        if (a.is_negative() != b.is_negative()) {
+            return a.is_negative();
+        }
+        // Same sign: two's complement orders like the unsigned limbs.
+        for (size_t i = LIMBS; i-- > 0;) {
+            if (a.words[i] != b.words[i]) {
+                return a.words[i] < b.words[i];
             }
         }
         return false;
     }
-
-    /**
-     * @brief Overloaded greater-than comparison operator.
-     * @param num The bigint to compare with.
-     * @return True if the current bigint is greater than the other.
-     */
-    bool operator>(const bigint &num) const{
-        if(*this < num || *this == num){
-            return false;
-        }else{
-            return true;
-        }
+    friend constexpr bool operator>(const wide_int &a, const wide_int &b) {
+        return b < a;
     }
-     /**
-     * @brief Overloaded less-than-or-equal comparison operator.
-     * @param num The bigint to compare with.
-     * @return True if the current bigint is less than or equal to the other.
-     */
-    bool operator<=(const bigint &num) const{
-        if(*this < num || *this == num){
-            return true;
-        }else{
-            return false;
-        }
+    friend constexpr bool operator<=(const wide_int &a, const wide_int &b) {
+        return !(b < a);
     }
-     /**
-     * @brief Overloaded greater-than-or-equal comparison operator.
-     * @param num The bigint to compare with.
-     * @return True if the current bigint is greater than or equal to the other.
-     */
-    bool operator>=(const bigint &num) const{
-        if(*this > num || *this == num){
-            return true;
-        }else{
-            return false;
-        }
+    friend constexpr bool operator>=(const wide_int &a, const wide_int &b) {
+        return !(a < b);
     }
-     /**
-     * @brief Pre-increment operator.
-     * @return A reference to the incremented bigint.
-     */
-    bigint &operator++(){
-        *this = *this + 1;
-        return *this;
+    friend std::ostream &operator<<(std::ostream &out, const wide_int &value) {
+        return out << value.to_bigint();
     }
-      /**
-     * @brief Post-increment operator.
-     * @return The bigint before incrementing.
-     */
-    bigint operator++(int){
-        bigint res = *this;
-        *this = *this + 1;
+
+private:
+    limb_array words{};
+
+    static constexpr limb addCarry(limb a, limb b, limb &carry) {
+        limb sum = a + b;
+        limb res = sum + carry;
+        carry = static_cast<limb>(sum < a) | static_cast<limb>(res < sum);
         return res;
     }
-     /**
-     * @brief Pre-decrement operator.
-     * @return A reference to the decremented bigint.
+    static constexpr limb subBorrow(limb a, limb b, limb &borrow) {
+        limb diff = a - b;
+        limb res = diff - borrow;
+        borrow = static_cast<limb>(a < b) | static_cast<limb>(diff < borrow);
+        return res;
+    }
+    /**
+     * @brief Carry chain unrolled over the limbs by a fold expression.
      */
-    bigint &operator--(){
-        *this = *this - 1;
-        return *this;
+    template <size_t... I>
+    static constexpr void addLimbs(limb_array &res, const limb_array &a, const limb_array &b, std::index_sequence<I...>) {
+        limb carry = 0;
+        ((res[I] = addCarry(a[I], b[I], carry)), ...);
+    }
+    template <size_t... I>
+    static constexpr void subLimbs(limb_array &res, const limb_array &a, const limb_array &b, std::index_sequence<I...>) {
+        limb borrow = 0;
+        ((res[I] = subBorrow(a[I], b[I], borrow)), ...);
     }
     /**
-     * @brief Post-decrement operator.
-     * @return The bigint before decrementing.
+     * @brief Divides unsigned magnitudes with Knuth's algorithm D.
      */
-    bigint operator--(int){
-        bigint res = *this;
-        *this = *this - 1;
-        return res;
+    static constexpr void divmodMagnitude(const limb_array &u, const limb_array &v, limb_array &q, limb_array &r) {
+        using bigint_detail::dlimb;
+        size_t n = LIMBS, m = LIMBS;
+        while (n > 0 && v[n - 1] == 0) {
+            --n;
+        }
+        while (m > 0 && u[m - 1] == 0) {
+            --m;
+        }
+        q = {};
+        r = {};
+        if (m < n) {
+            r = u;
+            return;
+        }
+        if (n == 1) {
+            limb rem = 0;
+            for (size_t i = m; i-- > 0;) {
+                dlimb cur = (static_cast<dlimb>(rem) << 64) | u[i];
+                q[i] = static_cast<limb>(cur / v[0]);
+                rem = static_cast<limb>(cur % v[0]);
+            }
+            r[0] = rem;
+            return;
+        }
+        unsigned shift = static_cast<unsigned>(std::countl_zero(v[n - 1]));
+        limb_array vn{};
+        std::array<limb, LIMBS + 1> un{};
+        for (size_t i = n; i-- > 0;) {
+            vn[i] = (v[i] << shift) | (shift != 0 && i > 0 ? v[i - 1] >> (64 - shift) : 0);
+        }
+        un[m] = shift != 0 ? u[m - 1] >> (64 - shift) : 0;
+        for (size_t i = m; i-- > 0;) {
+            un[i] = (u[i] << shift) | (shift != 0 && i > 0 ? u[i - 1] >> (64 - shift) : 0);
+        }
+        for (size_t j = m - n + 1; j-- > 0;) {
+            dlimb num = (static_cast<dlimb>(un[j + n]) << 64) | un[j + n - 1];
+            dlimb qhat = num / vn[n - 1];
+            dlimb rhat = num % vn[n - 1];
+            while ((qhat >> 64) != 0
+                   || qhat * vn[n - 2] > ((rhat << 64) | un[j + n - 2])) {
+                --qhat;
+                rhat += vn[n - 1];
+                if ((rhat >> 64) != 0) {
+                    break;
+                }
+            }
+            limb carry = 0, borrow = 0;
+            for (size_t i = 0; i < n; ++i) {
+                dlimb p = qhat * vn[i] + carry;
+                carry = static_cast<limb>(p >> 64);
+                un[i + j] = subBorrow(un[i + j], static_cast<limb>(p), borrow);
+            }
+            un[j + n] = subBorrow(un[j + n], carry, borrow);
+            if (borrow != 0) {
+                --qhat;
+                carry = 0;
+                for (size_t i = 0; i < n; ++i) {
+                    un[i + j] = addCarry(un[i + j], vn[i], carry);
+                }
+                un[j + n] += carry;
+            }
+            q[j] = static_cast<limb>(qhat);
+        }
+        for (size_t i = 0; i < n; ++i) {
+            r[i] = (un[i] >> shift) | (shift != 0 ? un[i + 1] << (64 - shift) : 0);
+        }
+    }
+    static constexpr std::pair<wide_int, wide_int> divmod(const wide_int &a, const wide_int &b) {
+        if (b == wide_int()) {
+            throw std::domain_error("Division by zero");
+        }
+        bool aNegative = a.is_negative(), bNegative = b.is_negative();
+        wide_int q, r;
+        divmodMagnitude(aNegative ? (-a).words : a.words, bNegative ? (-b).words : b.words, q.words, r.words);
+        if (aNegative != bNegative) {
+            q = -q;
+        }
+        if (aNegative) {
+            r = -r;
+        }
+        return {q, r};
     }
-
-
 };
 
+/// Unsigned fixed-width integer, e.g. wide_uint<256> for hashes.
+template <size_t Bits>
+using wide_uint = wide_int<Bits, false>;
 
-
-
-
-
-
-
-
-
+/**
+ * @brief Integer literal evaluated at compile time, e.g. 123456789012345678901234567890_big.
+ *
+ * Accepts decimal, 0x hex, 0b binary and 0 octal literals with ' separators.
+ * The result is the narrowest signed wide_int holding the value, so no text
+ * is parsed at run time; it converts implicitly to bigint by copying limbs.
+ * Invalid digits (e.g. 0b12_big) fail to compile.
+ */
+template <char... Chars>
+consteval auto operator""_big() {
+    constexpr char text[] = {Chars...};
+    constexpr size_t boundLimbs = sizeof...(Chars) * 4 / 64 + 1;
+    constexpr auto value = bigint_detail::parseLiteral<boundLimbs>(text, sizeof...(Chars));
+    // One spare bit for the sign, so that negating the literal cannot overflow.
+    constexpr size_t limbs = bigint_detail::literalBitWidth(value) / 64 + 1;
+    std::array<bigint_detail::limb, limbs> words{};
+    for (size_t i = 0; i < limbs; ++i) {
+        words[i] = value[i];
+    }
+    return wide_int<limbs * 64>(words);
+}
@@ -8,10 +8,20 @@
 
 
 #include <iostream>
+#include <atomic>
+#include <cstdlib>
 #include <fstream>
 #include <cassert>
+#include <cstring>
+#include <filesystem>
+#include <optional>
+#include <random>
+#include <sstream>
 #include "bigint.hpp"
 
+/// Number of passed and failed test cases so far.
+static int passed = 0, failed = 0;
+
 /**
  * @brief Logs the result of a test case and tracks passed/failed tests.
  * 
@@ -19,7 +29,6 @@
  * @param result Boolean indicating if the test passed or failed.
  */
 void logTest(const std::string &testName, bool result) {
-    static int passed = 0, failed = 0;
     if (result) {
         ++passed;
         std::cout << "[PASSED] " << testName << std::endl;
@@ -143,6 +152,63 @@ void Integration_tests() {
         logTest("Increment and Decrement", false);
         std::cout << "Error: " << e.what() << '\n';
     }
+    try {
+        bigint a("340282366920938463463374607431768211455");
+        bigint b = a;
+        ++b;
+        bigint c = -b;
+        ++c;
+        bigint zero = 1;
+        --zero;
+        --zero;
+        logTest("Increment and Decrement (Carry)", b == bigint("340282366920938463463374607431768211456") &&
+                                                   c == -a && --b == a && zero == -1);
+    } catch (const std::exception &e) {
+        logTest("Increment and Decrement (Carry)", false);
+        std::cout << "Error: " << e.what() << '\n';
+    }
+    try {
+        bigint a("-123456789012345678901234567890");
+        int64_t k = -987654321;
+        bool same = a + k == a + bigint(k) && a - k == a - bigint(k) && a * k == a * bigint(k) &&
+                    a / k == a / bigint(k) && a % k == a % bigint(k) && k - a == bigint(k) - a &&
+                    k / a == 0 && k % a == k && 3 * a == a * 3;
+        bigint b = a;
+        b *= INT64_MIN;
+        b /= INT64_MIN;
+        same = same && b == a && bigint(INT64_MIN) == INT64_MIN && a < 0 && 0 > a && a != k;
+        b %= 1000;
+        same = same && b == -890;
+        logTest("Mixed Integer Operators", same);
+    } catch (const std::exception &e) {
+        logTest("Mixed Integer Operators", false);
+        std::cout << "Error: " << e.what() << '\n';
+    }
+
+    try {
+        bigint a("99999999999999999999999999999999999999999");
+        bigint b("12345");
+        bigint c = a;
+        c += b;
+        logTest("Compound Addition", c == a + b);
+        c -= a;
+        logTest("Compound Subtraction", c == b);
+        c *= a;
+        logTest("Compound Multiplication", c == a * b);
+        bigint d = a;
+        d += d;
+        logTest("Compound Aliasing", d == a + a);
+        d *= d;
+        logTest("Compound Aliasing", d == (a + a) * (a + a));
+        d -= d;
+        logTest("Compound Aliasing", d == bigint(0));
+        bigint e = b;
+        (e += a) -= b;
+        logTest("Compound Chaining", e == a);
+    } catch (const std::exception &e) {
+        logTest("Compound Assignment", false);
+        std::cout << "Error: " << e.what() << '\n';
+    }
 
     try {
         bigint a("12345");
@@ -179,6 +245,35 @@ void Edge_cases() {
         logTest("Addition", false);
         std::cout << "Error: " << e.what() << '\n';
     }
+    try {
+        bigint a("18446744073709551615");
+        bigint b = a + bigint(1);
+        logTest("Limb Carry", b == bigint("18446744073709551616"));
+        logTest("Limb Borrow", b - bigint(1) == a);
+        logTest("Limb Product", a * a == bigint("340282366920938463426481119284349108225"));
+    } catch (const std::exception &e) {
+        logTest("Limb Boundaries", false);
+        std::cout << "Error: " << e.what() << '\n';
+    }
+    try {
+        bigint max128("340282366920938463463374607431768211455");
+        logTest("Inline Carry", max128 + bigint(1) == bigint("340282366920938463463374607431768211456"));
+        logTest("Inline Borrow", -max128 - bigint(1) == bigint("-340282366920938463463374607431768211456"));
+        logTest("Inline Product", bigint(INT64_MIN) * bigint(INT64_MIN) == bigint("85070591730234615865843651857942052864"));
+        logTest("Inline Comparison", bigint("18446744073709551616") > bigint("18446744073709551615") && bigint(-1) < bigint(0));
+        logTest("Inline Size", sizeof(bigint) <= 40);
+    } catch (const std::exception &e) {
+        logTest("Inline Values", false);
+        std::cout << "Error: " << e.what() << '\n';
+    }
+    try {
+        std::ostringstream out;
+        out << bigint(INT64_MIN) << ' ' << bigint("-0") << ' ' << bigint("-00012345678901234567890123");
+        logTest("Output Operator", out.str() == "-9223372036854775808 0 -12345678901234567890123");
+    } catch (const std::exception &e) {
+        logTest("Output Operator", false);
+        std::cout << "Error: " << e.what() << '\n';
+    }
 }
 
 /**
@@ -198,6 +293,12 @@ void Error_handling() {
     } catch (const std::invalid_argument &e) {
         logTest("String Constructor (Empty String)", true);
     }
+    try {
+        bigint sign("-");
+        logTest("String Constructor (Sign Only)", false);
+    } catch (const std::invalid_argument &e) {
+        logTest("String Constructor (Sign Only)", true);
+    }
 
 }
 
@@ -219,6 +320,155 @@ void Consistency_tests(){
         std::cout << "Error: " << e.what() << '\n';
 }
 }
+/**
+ * @brief Tests the opt-in lazy expression layer against eager evaluation.
+ */
+void Expression_tests(){
+    std::cout << "Expression Tests" << std::endl;
+    try {
+        bigint a("123456789012345678901234567890");
+        bigint b("-98765432109876543210");
+        bigint c("55555555555555555555555555555555555");
+        bigint d("7");
+        bigint sum = lazy(a) + b - c + d;
+        logTest("Lazy Sum", sum == a + b - c + d);
+        bigint e = a;
+        e = lazy(e) - c - e;
+        logTest("Lazy Sum (Aliasing)", e == -c);
+        bigint f = d;
+        f += lazy(a) * b;
+        logTest("Fused Multiply-Add", f == d + a * b);
+        f -= lazy(c) * c;
+        logTest("Fused Multiply-Subtract", f == d + a * b - c * c);
+        bigint g = a * (lazy(b) + c);
+        logTest("Lazy Sum Product", g == a * (b + c));
+    } catch (const std::exception &e) {
+        logTest("Expression Tests", false);
+        std::cout << "Error: " << e.what() << '\n';
+    }
+}
+
+/// Number of allocations made through the global operator new.
+static std::atomic<size_t> globalAllocations{0};
+
+/**
+ * @brief Replaces the global operator new (and delete) to count heap allocations.
+ */
+[[gnu::noinline]] void *operator new(size_t bytes) {
+    globalAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *p = std::malloc(bytes == 0 ? 1 : bytes)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+[[gnu::noinline]] void operator delete(void *p) noexcept {
+    std::free(p);
+}
+[[gnu::noinline]] void operator delete(void *p, size_t) noexcept {
+    std::free(p);
+}
+
+/**
+ * @brief A memory resource that counts the bytes still allocated from it.
+ */
+class countingResource : public std::pmr::memory_resource {
+public:
+    size_t live = 0;
+    size_t allocations = 0;
+
+private:
+    void *do_allocate(size_t bytes, size_t alignment) override {
+        live += bytes;
+        ++allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void *p, size_t bytes, size_t alignment) override {
+        live -= bytes;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+        return this == &other;
+    }
+};
+
+/**
+ * @brief Tests memory resources, arenas and allocation reuse by rvalue operators.
+ */
+void Allocator_tests(){
+    std::cout << "Allocator Tests" << std::endl;
+    try {
+        bigint a("123456789012345678901234567890123456789012345678901234567890");
+        bigint b("-98765432109876543210987654321098765432109876543210");
+        bigint expected = a * b + a - b;
+        countingResource counter;
+        bigint kept;
+        {
+            bigint_resource_scope scope(&counter);
+            bigint product = a * b + a - b;
+            logTest("Scoped Resource", product == expected && product.resource() == &counter && counter.allocations > 0);
+            kept = product;
+        }
+        logTest("Scoped Resource Release", counter.live == 0 && kept == expected && kept.resource() != &counter);
+        bigint own(a, &counter);
+        own *= b;
+        logTest("Explicit Resource", own == a * b && own.resource() == &counter && counter.live > 0);
+        bigint reference = a;
+        for (int i = 0; i < 50; ++i) {
+            reference = reference * b + a;
+        }
+        bigint kept2(0, &counter);
+        {
+            bigint_arena arena;
+            bigint x = a;
+            for (int i = 0; i < 50; ++i) {
+                x = x * b + a;
+            }
+            logTest("Arena Temporaries", x == reference && x.resource() == arena.resource());
+            kept2 = x / a;
+        }
+        logTest("Arena Result Survives", kept2 == reference / a && kept2.resource() == &counter);
+        bigint c = a * a, d = b * b, e = -c;
+        bigint chained, negated;
+        countingResource chainCounter;
+        {
+            bigint_resource_scope scope(&chainCounter);
+            chained = c + d - e + c;
+            size_t chainAllocations = chainCounter.allocations;
+            negated = -(c * d) + e * 3;
+            logTest("Rvalue Chain Allocations", chainAllocations == 1 && chainCounter.allocations == 3);
+        }
+        bool rvalues = chained == c * 3 + d && negated == c * -3 - c * d;
+        const bigint values[] = {0, 1, -7, a, b, c, e, d - 1};
+        for (const bigint &x : values) {
+            for (const bigint &y : values) {
+                rvalues = rvalues && (x + y) - (y - x) == x * 2 && x - (y + 0) == x - y && (x * 1) * (y * 1) == x * y
+                          && (x + 0) + (y + 0) == x + y && (x + 0) - (y + 0) == x - y && 7 - (y + 0) == 7 - y
+                          && -(x + 0) == -x && (x + 0) * 5 == x * 5 && (x + 0) / 7 == x / 7;
+            }
+            bigint alias = x;
+            rvalues = rvalues && alias + std::move(alias) == x * 2;
+        }
+        logTest("Rvalue Operators", rvalues);
+        bigint f(std::string(900, '7')), g(std::string(870, '3'));
+        bigint fusedReference = f * g + f * g;
+        std::vector<std::byte> pool(1 << 20);
+        std::pmr::monotonic_buffer_resource fixed(pool.data(), pool.size(), std::pmr::null_memory_resource());
+        bool scratchOnArena = false;
+        {
+            bigint_arena arena(1 << 16, &fixed);
+            bigint h(f, arena.resource()), sum(f * g, arena.resource());
+            size_t before = globalAllocations.load();
+            h *= g;
+            sum += lazy(f) * g;
+            scratchOnArena = globalAllocations.load() == before && h == f * g && sum == fusedReference;
+        }
+        logTest("Scratch Buffers On Arena", scratchOnArena);
+    } catch (const std::exception &e) {
+        logTest("Allocator Tests", false);
+        std::cout << "Error: " << e.what() << '\n';
+    }
+}
+
 /**
  * @brief Generates a random `bigint` with a specified number of digits.
  * @param digits The number of digits for the random bigint.
@@ -252,13 +502,271 @@ void Randomizing_tests() {
         bigint C = generateRandomBigint(10);
         bigint D = A + B - C;
         bigint E = A - C + B;
+        bigint F = lazy(A) - C + B;
         logTest("Randomizing Tests", D == E);
+        logTest("Randomizing Tests (Lazy)", D == F);
     } catch (const std::exception &e) {
         logTest("Randomizing Tests", false);
         std::cout << "Error: " << e.what() << '\n';
     }
 
 }
+/**
+ * @brief Checks Karatsuba, Toom-3 and NTT multiplication against schoolbook.
+ *
+ * Lowers the algorithm thresholds so the fast paths run on moderate sizes,
+ * including unbalanced operands, then compares with schoolbook results.
+ */
+void Multiplication_tests() {
+    std::cout << "Multiplication Tests" << std::endl;
+    size_t karatsuba = bigint_tuning::karatsubaThreshold;
+    size_t toom3 = bigint_tuning::toom3Threshold;
+    size_t ntt = bigint_tuning::nttThreshold;
+    size_t sqrKaratsuba = bigint_tuning::sqrKaratsubaThreshold;
+    size_t sqrToom3 = bigint_tuning::sqrToom3Threshold;
+    size_t sqrNtt = bigint_tuning::sqrNttThreshold;
+    try {
+        bool same = true;
+        for (int i = 0; i < 20; ++i) {
+            bigint a = generateRandomBigint(200 + std::rand() % 2000);
+            bigint b = generateRandomBigint(200 + std::rand() % 2000);
+            bigint_tuning::karatsubaThreshold = 1000000;
+            bigint_tuning::toom3Threshold = 1000000;
+            bigint schoolbook = a * b;
+            bigint_tuning::karatsubaThreshold = 2;
+            bigint_tuning::toom3Threshold = 1000000;
+            same = same && a * b == schoolbook;
+            bigint_tuning::toom3Threshold = 6;
+            same = same && a * b == schoolbook;
+        }
+        logTest("Karatsuba and Toom-3", same);
+    } catch (const std::exception &e) {
+        logTest("Karatsuba and Toom-3", false);
+        std::cout << "Error: " << e.what() << '\n';
+    }
+    try {
+        bool same = true;
+        for (int i = 0; i < 20; ++i) {
+            bigint a = generateRandomBigint(1 + std::rand() % 3000);
+            bigint b = generateRandomBigint(1 + std::rand() % 3000);
+            bigint_tuning::karatsubaThreshold = 1000000;
+            bigint_tuning::toom3Threshold = 1000000;
+            bigint_tuning::nttThreshold = 1000000;
+            bigint schoolbook = a * b;
+            bigint_tuning::karatsubaThreshold = 1;
+            bigint_tuning::toom3Threshold = 1;
+            bigint_tuning::nttThreshold = 1;
+            same = same && a * b == schoolbook;
+        }
+        bigint nines(std::string(2000, '9'));
+        bigint_tuning::nttThreshold = 1000000;
+        bigint_tuning::sqrNttThreshold = 1000000;
+        bigint schoolbook = nines * nines;
+        bigint_tuning::nttThreshold = 1;
+        bigint_tuning::sqrNttThreshold = 1;
+        same = same && nines * nines == schoolbook;
+        bigint_tuning::sqrNttThreshold = sqrNtt;
+        logTest("NTT Multiplication", same);
+    } catch (const std::exception &e) {
+        logTest("NTT Multiplication", false);
+        std::cout << "Error: " << e.what() << '\n';
+    }
+    size_t parallel = bigint_tuning::parallelThreshold;
+    try {
+        bool same = true;
+        for (int i = 0; i < 10; ++i) {
+            bigint a = generateRandomBigint(500 + std::rand() % 20000);
+            bigint b = generateRandomBigint(500 + std::rand() % 20000);
+            bigint_tuning::nttThreshold = i % 2 == 0 ? 1000000 : 64;
+            bigint_tuning::threads = 1;
+            bigint serial = a * b;
+            bigint_tuning::threads = 4;
+            bigint_tuning::parallelThreshold = 8;
+            same = same && a * b == serial;
+            bigint_tuning::parallelThreshold = parallel;
+        }
+        logTest("Parallel Multiplication", same);
+    } catch (const std::exception &e) {
+        logTest("Parallel Multiplication", false);
+        std::cout << "Error: " << e.what() << '\n';
+    }
+    try {
+        bool same = true;
+        for (int i = 0; i < 30; ++i) {
+            bigint a = generateRandomBigint(1 + std::rand() % 4000);
+            bigint copy = a;
+            bigint product = a * copy;
+            bigint_tuning::sqrKaratsubaThreshold = i % 3 == 0 ? 1000000 : 4;
+            bigint_tuning::sqrToom3Threshold = i % 3 == 1 ? 1000000 : 12;
+            bigint_tuning::sqrNttThreshold = i % 2 == 0 ? 1000000 : 40;
+            bigint squared = a;
+            squared *= squared;
+            same = same && square(a) == product && a * a == product && squared == product && square(-a) == product;
+            bigint_tuning::sqrKaratsubaThreshold = sqrKaratsuba;
+            bigint_tuning::sqrToom3Threshold = sqrToom3;
+            bigint_tuning::sqrNttThreshold = sqrNtt;
+        }
+        bigint top = pow(bigint(2), 64 * 50) - 1;
+        same = same && square(top) == top * (top + 0) && square(bigint()) == 0 && square(bigint(-3)) == 9;
+        logTest("Squaring", same);
+    } catch (const std::exception &e) {
+        logTest("Squaring", false);
+        std::cout << "Error: " << e.what() << '\n';
+    }
+    bigint_tuning::threads = 1;
+    bigint_tuning::parallelThreshold = parallel;
+    bigint_tuning::sqrKaratsubaThreshold = sqrKaratsuba;
+    bigint_tuning::sqrToom3Threshold = sqrToom3;
+    bigint_tuning::sqrNttThreshold = sqrNtt;
+    bigint_tuning::karatsubaThreshold = karatsuba;
+    bigint_tuning::toom3Threshold = toom3;
+    bigint_tuning::nttThreshold = ntt;
+}
+
+/**
+ * @brief Tests division, modulo and divmod, including the Newton path.
+ */
+void Division_tests() {
+    std::cout << "Division Tests" << std::endl;
+    try {
+        bigint a("838102050");
+        bigint b("12345");
+        logTest("Division", a / b == bigint("67890"));
+        logTest("Division (Signs)", bigint(-7) / bigint(2) == bigint(-3) && bigint(7) / bigint(-2) == bigint(-3));
+        logTest("Modulo (Signs)", bigint(-7) % bigint(2) == bigint(-1) && bigint(7) % bigint(-2) == bigint(1));
+        bigint c("123456789012345678901234567890");
+        c /= bigint("1000000000");
+        logTest("Division Assignment", c == bigint("123456789012345678901"));
+        c %= bigint("1000");
+        logTest("Modulo Assignment", c == bigint("901"));
+    } catch (const std::exception &e) {
+        logTest("Division", false);
+        std::cout << "Error: " << e.what() << '\n';
+    }
+    try {
+        bigint zero;
+        bigint invalid = bigint(1) / zero;
+        logTest("Division by Zero", false);
+    } catch (const std::domain_error &e) {
+        logTest("Division by Zero", true);
+    }
+    try {
+        bigint invalid = bigint(1) % 0;
+        logTest("Division by Zero (int64_t)", false);
+    } catch (const std::domain_error &e) {
+        logTest("Division by Zero (int64_t)", true);
+    }
+    size_t newton = bigint_tuning::newtonThreshold;
+    try {
+        bool consistent = true;
+        for (int i = 0; i < 20; ++i) {
+            bigint a = generateRandomBigint(1 + std::rand() % 4000);
+            bigint b = generateRandomBigint(1 + std::rand() % 2000);
+            bigint_tuning::newtonThreshold = 1000000;
+            std::pair<bigint, bigint> knuth = divmod(a, b);
+            bigint_tuning::newtonThreshold = 8;
+            std::pair<bigint, bigint> fast = divmod(a, b);
+            consistent = consistent && knuth == fast && knuth.first * b + knuth.second == a;
+            bigint absRem = knuth.second < bigint(0) ? -knuth.second : knuth.second;
+            bigint absDiv = b < bigint(0) ? -b : b;
+            consistent = consistent && absRem < absDiv;
+        }
+        logTest("Knuth and Newton Division", consistent);
+    } catch (const std::exception &e) {
+        logTest("Knuth and Newton Division", false);
+        std::cout << "Error: " << e.what() << '\n';
+    }
+    bigint_tuning::newtonThreshold = newton;
+}
+
+/**
+ * @brief Tests divide-and-conquer decimal parsing and printing.
+ *
+ * Lowers the conversion threshold so the power tree is used on moderate sizes
+ * and checks that text survives a round trip, including zero runs and padding.
+ */
+void Conversion_tests() {
+    std::cout << "Conversion Tests" << std::endl;
+    try {
+        std::string text = "-123456789012345678901234567890";
+        std::string_view view(text);
+        bool views = bigint(view) == bigint(text) && bigint(view.substr(1, 5)) == 12345
+                     && bigint(text.c_str()) == bigint(text) && bigint(std::move(text)) == bigint("-123456789012345678901234567890");
+        bool threw = false;
+        try {
+            bigint bad(std::string_view("12a"));
+        } catch (const std::invalid_argument &) {
+            threw = true;
+        }
+        logTest("String View Constructor", views && threw);
+    } catch (const std::exception &e) {
+        logTest("String View Constructor", false);
+        std::cout << "Error: " << e.what() << '\n';
+    }
+    size_t decimal = bigint_tuning::decimalThreshold;
+    try {
+        bigint_tuning::decimalThreshold = 2;
+        bool same = true;
+        for (int i = 0; i < 20; ++i) {
+            std::string digits = "1";
+            size_t length = 1 + static_cast<size_t>(std::rand() % 5000);
+            for (size_t j = 1; j < length; ++j) {
+                digits += (i % 2 == 0) ? static_cast<char>('0' + std::rand() % 10) : '0';
+            }
+            std::ostringstream out;
+            out << bigint("-000" + digits);
+            same = same && out.str() == "-" + digits;
+        }
+        logTest("Decimal Round Trip", same);
+        bigint padded(std::string(3000, '0') + "42");
+        logTest("Decimal Leading Zeros", padded == bigint(42));
+    } catch (const std::exception &e) {
+        logTest("Decimal Round Trip", false);
+        std::cout << "Error: " << e.what() << '\n';
+    }
+    bigint_tuning::decimalThreshold = decimal;
+    try {
+        std::string digits = "9";
+        for (int i = 0; i < 150000; ++i) {
+            digits += static_cast<char>('0' + std::rand() % 10);
+        }
+        bigint expected("-" + digits);
+        bigint_parser parser;
+        parser.feed("-", 1);
+        for (size_t pos = 0; pos < digits.size();) {
+            size_t len = std::min<size_t>(digits.size() - pos, 1 + static_cast<size_t>(std::rand() % 7000));
+            parser.feed(digits.data() + pos, len);
+            pos += len;
+        }
+        logTest("Chunked Parser", parser.digits() == digits.size() && parser.finish() == expected);
+
+        std::istringstream in("  123\n-00045x " + digits + " abc");
+        bigint a, b, c, d;
+        in >> a >> b;
+        char x;
+        in >> x >> c;
+        bool parsed = a == 123 && b == -45 && x == 'x' && c == -expected && in;
+        in >> d;
+        logTest("Stream Extraction", parsed && in.fail() && d == 0);
+        std::istringstream plus("+123 +-4");
+        bigint e, f = 7;
+        plus >> e;
+        bool positive = e == 123 && plus;
+        plus >> f;
+        logTest("Stream Plus Sign", positive && plus.fail() && f == 7);
+    } catch (const std::exception &e) {
+        logTest("Stream Extraction", false);
+        std::cout << "Error: " << e.what() << '\n';
+    }
+    try {
+        bigint_parser parser;
+        parser.feed("12a", 3);
+        logTest("Chunked Parser Invalid", false);
+    } catch (const std::invalid_argument &) {
+        logTest("Chunked Parser Invalid", true);
+    }
+}
+
 /**
  * @brief Stress tests with very large `bigint` values.
  */
@@ -276,9 +784,564 @@ void Stress_tests() {
     }
 }
 
+/**
+ * @brief Checks every SIMD kernel level against the generic add, subtract and compare kernels.
+ */
+void Kernel_tests() {
+    std::cout << "Kernel Tests" << std::endl;
+    bigint_detail::limbKernels saved = bigint_detail::activeKernels();
+    try {
+        bigint limbBase("18446744073709551616");
+        bigint power = 1;
+        for (int i = 0; i < 45; ++i) {
+            power *= limbBase;
+        }
+        bigint allOnes = power - 1;
+        std::vector<bigint> values;
+        for (int i = 0; i < 20; ++i) {
+            values.push_back(generateRandomBigint(100 + std::rand() % 1500));
+        }
+        auto run = [&]() {
+            std::vector<bigint> out;
+            out.push_back(allOnes + 1);
+            out.push_back(power - 1);
+            out.push_back(allOnes + allOnes);
+            for (size_t i = 0; i + 1 < values.size(); ++i) {
+                out.push_back(values[i] + values[i + 1]);
+                out.push_back(values[i] - values[i + 1]);
+                out.push_back(values[i] < values[i + 1] ? 1 : 0);
+                out.push_back(values[i] + 1 > values[i] ? 1 : 0);
+            }
+            return out;
+        };
+        bigint_detail::activeKernels() = bigint_detail::kernelsFor(bigint_detail::simdLevel::generic);
+        std::vector<bigint> expected = run();
+        bool same = expected[0] == power && expected[1] == allOnes;
+        int best = static_cast<int>(bigint_detail::detectSimd());
+        for (int level = 0; level <= best; ++level) {
+            bigint_detail::activeKernels() = bigint_detail::kernelsFor(static_cast<bigint_detail::simdLevel>(level));
+            same = same && run() == expected;
+        }
+        logTest("Dispatched Kernels", same);
+    } catch (const std::exception &e) {
+        logTest("Dispatched Kernels", false);
+        std::cout << "Error: " << e.what() << '\n';
+    }
+    bigint_detail::activeKernels() = saved;
+}
+
+/**
+ * @brief Tests element-wise batch arithmetic against per-element operators.
+ */
+void Batch_tests() {
+    std::cout << "Batch Tests" << std::endl;
+    size_t parallel = bigint_tuning::parallelThreshold;
+    try {
+        std::vector<bigint> xs;
+        std::vector<bigint> ys;
+        for (int i = 0; i < 200; ++i) {
+            int digits = i % 4 == 0 ? 1 + std::rand() % 30 : 1 + std::rand() % 600;
+            xs.push_back(i % 17 == 0 ? bigint(0) : generateRandomBigint(digits));
+            ys.push_back(i % 5 == 0 ? -xs.back() : generateRandomBigint(1 + std::rand() % 600));
+        }
+        bigint_batch a(xs);
+        bigint_batch b(ys);
+        bool same = a.size() == xs.size() && a.to_vector() == xs;
+        for (size_t threads : {size_t{1}, size_t{4}}) {
+            bigint_tuning::threads = threads;
+            bigint_tuning::parallelThreshold = threads > 1 ? 8 : parallel;
+            bigint_batch sum = a + b;
+            bigint_batch difference = a - b;
+            bigint_batch product = a * b;
+            std::vector<int> order = compare(a, b);
+            for (size_t i = 0; i < xs.size(); ++i) {
+                int expected = xs[i] < ys[i] ? -1 : (xs[i] == ys[i] ? 0 : 1);
+                same = same && sum[i] == xs[i] + ys[i] && difference[i] == xs[i] - ys[i] &&
+                       product[i] == xs[i] * ys[i] && order[i] == expected;
+            }
+        }
+        logTest("Batch Element-wise", same);
+    } catch (const std::exception &e) {
+        logTest("Batch Element-wise", false);
+        std::cout << "Error: " << e.what() << '\n';
+    }
+    bigint_tuning::threads = 1;
+    bigint_tuning::parallelThreshold = parallel;
+    try {
+        bigint_batch a(std::vector<bigint>{1, 2});
+        bigint_batch b(std::vector<bigint>{1});
+        bigint_batch c = a + b;
+        logTest("Batch Size Mismatch", false);
+    } catch (const std::invalid_argument &) {
+        logTest("Batch Size Mismatch", true);
+    }
+}
+
+/**
+ * @brief Reference modular exponentiation by binary powering with operator%.
+ */
+bigint slowPowmod(bigint base, bigint exponent, const bigint &modulus) {
+    bigint result = 1;
+    base = (base % modulus + modulus) % modulus;
+    while (exponent > 0) {
+        if (exponent % 2 == 1) {
+            result = result * base % modulus;
+        }
+        base = base * base % modulus;
+        exponent /= 2;
+    }
+    return result % modulus;
+}
+
+/**
+ * @brief Tests bigint_modulus reduction, mulmod and powmod against operator%.
+ */
+void Modular_tests() {
+    std::cout << "Modular Tests" << std::endl;
+    size_t montgomery = bigint_tuning::montgomeryThreshold;
+    try {
+        bool same = true;
+        for (int i = 0; i < 30; ++i) {
+            bigint m = generateRandomBigint(1 + std::rand() % 150);
+            if (m < 0) {
+                m = -m;
+            }
+            bigint_modulus ctx(m);
+            bigint a = generateRandomBigint(1 + std::rand() % 300);
+            bigint b = generateRandomBigint(1 + std::rand() % 150);
+            bigint e = generateRandomBigint(1 + std::rand() % 40);
+            if (e < 0) {
+                e = -e;
+            }
+            bigint expected = slowPowmod(a, e, m);
+            bigint_tuning::montgomeryThreshold = montgomery;
+            same = same && ctx.powmod(a, e) == expected;
+            bigint_tuning::montgomeryThreshold = 1;
+            same = same && ctx.powmod(a, e) == expected;
+            same = same && ctx.mulmod(a, b) == ((a * b) % m + m) % m;
+            same = same && ctx.reduce(a) == (a % m + m) % m;
+        }
+        logTest("Powmod and Mulmod", same);
+    } catch (const std::exception &e) {
+        logTest("Powmod and Mulmod", false);
+        std::cout << "Error: " << e.what() << '\n';
+    }
+    bigint_tuning::montgomeryThreshold = montgomery;
+    try {
+        bigint_modulus one(1);
+        bigint_modulus p(bigint("1000000007"));
+        logTest("Powmod Edge Cases", one.powmod(5, 3) == 0 && p.powmod(0, 0) == 1 && p.powmod(7, 0) == 1 &&
+                                     p.powmod(-2, 3) == bigint(1000000007 - 8) &&
+                                     p.powmod(2, bigint("1000000006")) == 1);
+    } catch (const std::exception &e) {
+        logTest("Powmod Edge Cases", false);
+        std::cout << "Error: " << e.what() << '\n';
+    }
+    try {
+        bigint m("170141183460469231731687303715884105727170141183460469231731687303715884105727");
+        bigint a = generateRandomBigint(70), b = generateRandomBigint(70), e = generateRandomBigint(60);
+        bigint expected = ((a * b) % m + m) % m, expectedPower = slowPowmod(a, e < 0 ? -e : e, m);
+        std::vector<std::byte> pool(1 << 20);
+        std::pmr::monotonic_buffer_resource fixed(pool.data(), pool.size(), std::pmr::null_memory_resource());
+        bool reused = true;
+        {
+            bigint_arena arena(1 << 16, &fixed);
+            bigint_modulus ctx(m, arena.resource());
+            bigint base(a, arena.resource()), factor(b, arena.resource()), exponent(e < 0 ? -e : e, arena.resource());
+            size_t before = globalAllocations.load();
+            for (int i = 0; i < 100; ++i) {
+                reused = reused && ctx.mulmod(base, factor) == expected;
+            }
+            reused = reused && ctx.powmod(base, exponent) == expectedPower && globalAllocations.load() == before;
+        }
+        logTest("Modulus Scratch On Arena", reused);
+    } catch (const std::exception &e) {
+        logTest("Modulus Scratch On Arena", false);
+        std::cout << "Error: " << e.what() << '\n';
+    }
+    try {
+        bigint m("1000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000007");
+        bigint a("123456789123456789123456789123456789123456789123456789123456789123456789123456789123456789");
+        std::optional<bigint_modulus> built, copied;
+        bigint_modulus outer(m);
+        {
+            bigint_arena arena;
+            built.emplace(m);
+            copied.emplace(outer);
+        }
+        logTest("Modulus Outlives Arena", built->resource() == std::pmr::get_default_resource()
+                                              && built->powmod(a, m - 2) == outer.powmod(a, m - 2)
+                                              && copied->mulmod(a, a) == outer.mulmod(a, a));
+    } catch (const std::exception &e) {
+        logTest("Modulus Outlives Arena", false);
+        std::cout << "Error: " << e.what() << '\n';
+    }
+    try {
+        bigint_modulus zero(0);
+        logTest("Invalid Modulus", false);
+    } catch (const std::domain_error &) {
+        logTest("Invalid Modulus", true);
+    }
+    try {
+        bigint_modulus p(bigint("97"));
+        p.powmod(2, -1);
+        logTest("Negative Exponent", false);
+    } catch (const std::domain_error &) {
+        logTest("Negative Exponent", true);
+    }
+}
+
+/**
+ * @brief Tests the opt-in operation counters, size histograms and tier timers.
+ */
+void Stats_tests() {
+    std::cout << "Instrumentation Tests" << std::endl;
+    // About 2960 limbs each, which falls in the 2048-4095 limb bucket (12) and multiplies by Toom-3.
+    bigint a = generateRandomBigint(57000);
+    bigint b = generateRandomBigint(57000);
+    bigint_stats::reset();
+    bigint_stats before = bigint_stats::snapshot();
+    bigint product = a * b;
+    bigint sum = a + b;
+    bool less = a < b;
+    std::ostringstream text;
+    text << less;
+    text << sum;
+    bigint_stats stats = bigint_stats::snapshot().since(before);
+    if (!bigint_stats::enabled) {
+        logTest("Stats Compiled Out", stats.count(bigint_op::mul) == 0 && stats.allocations == 0);
+        return;
+    }
+    logTest("Operation Counts", stats.count(bigint_op::mul) == 1 && stats.count(bigint_op::add) == 1
+                                    && stats.count(bigint_op::compare) == 1 && stats.count(bigint_op::print) == 1);
+    logTest("Size Histogram", stats.sizes[static_cast<size_t>(bigint_op::mul)][12] == 1);
+    logTest("Tier Counts", stats.count(bigint_tier::mulToom3) >= 1 && stats.count(bigint_tier::mulBasecase) > 1
+                               && stats.nanos(bigint_tier::mulBasecase) > 0);
+    logTest("Allocation Tracking", stats.allocations > 0 && stats.bytesAllocated >= 6000 * sizeof(uint64_t));
+    std::ostringstream report;
+    stats.dump(report);
+    logTest("Stats Dump", report.str().find("mul 1 [2048:1]") != std::string::npos
+                              && report.str().find("mul_toom3") != std::string::npos);
+    bigint_stats::reset();
+    logTest("Stats Reset", bigint_stats::snapshot().count(bigint_op::mul) == 0);
+}
+
+/**
+ * @brief Tests binary stream and file round trips, mapped views and malformed input.
+ */
+void Serialization_tests() {
+    std::cout << "Serialization Tests" << std::endl;
+    std::vector<bigint> values = {bigint(0), bigint(-1), bigint(INT64_MIN), bigint("340282366920938463463374607431768211456")};
+    for (int i = 0; i < 20; ++i) {
+        values.push_back(generateRandomBigint(1 + std::rand() % 3000));
+    }
+    try {
+        std::stringstream single;
+        for (const bigint &value : values) {
+            value.write_binary(single);
+        }
+        bool same = single.str().size() == [&] {
+            size_t total = 0;
+            for (const bigint &value : values) {
+                total += value.binary_size();
+            }
+            return total;
+        }();
+        for (const bigint &value : values) {
+            same = same && bigint::read_binary(single) == value;
+        }
+        logTest("Binary Round Trip", same);
+
+        std::stringstream file;
+        write_bigints(file, values);
+        std::string bytes = file.str();
+        logTest("Bulk Round Trip", read_bigints(file) == values);
+
+        std::vector<uint64_t> aligned((bytes.size() + 7) / 8);
+        std::memcpy(aligned.data(), bytes.data(), bytes.size());
+        bigint_file_view view(aligned.data(), bytes.size());
+        bool viewed = view.size() == values.size();
+        for (size_t i = 0; i < view.size() && viewed; ++i) {
+            viewed = view[i] == values[i] && view[i].to_bigint() == values[i];
+        }
+        std::ostringstream printed;
+        printed << view[1] << ' ' << view[3];
+        logTest("File View", viewed && printed.str() == "-1 340282366920938463463374607431768211456");
+
+        std::string path = (std::filesystem::temp_directory_path() / "bigint_test_values.bin").string();
+        std::ofstream(path, std::ios::binary) << bytes;
+        bool mapped;
+        {
+            bigint_mapped_file map(path);
+            mapped = map.size() == values.size() && map[values.size() - 1] == values.back();
+        }
+        std::filesystem::remove(path);
+        logTest("Mapped File", mapped);
+    } catch (const std::exception &e) {
+        logTest("Serialization", false);
+        std::cout << "Error: " << e.what() << '\n';
+    }
+    try {
+        std::stringstream truncated;
+        values.back().write_binary(truncated);
+        std::string text = truncated.str();
+        truncated.str(text.substr(0, text.size() - 1));
+        bigint::read_binary(truncated);
+        logTest("Truncated Binary", false);
+    } catch (const std::invalid_argument &) {
+        logTest("Truncated Binary", true);
+    }
+    try {
+        uint64_t words[3] = {1, 0, 0};
+        std::memcpy(words, "BIGINT01", 8);
+        bigint_file_view(words, sizeof(words));
+        words[1] = 1;
+        words[2] = 0;
+        bigint_file_view(words, sizeof(words))[0];
+        logTest("Malformed File", false);
+    } catch (const std::invalid_argument &) {
+        logTest("Malformed File", true);
+    }
+}
+
+/**
+ * @brief Tests integer powers, square roots and k-th roots.
+ */
+void Power_tests() {
+    std::cout << "Power and Root Tests" << std::endl;
+    try {
+        bigint big("123456789012345678901234567890");
+        bigint cube = big * big * big;
+        bool powers = pow(big, 3) == cube && pow(bigint(-2), 127) == -pow(bigint(2), 127) && pow(bigint(0), 0) == 1
+                      && pow(bigint(-7), 0) == 1 && pow(bigint(0), 5) == 0 && pow(bigint(1024), 20) == pow(bigint(2), 200);
+        logTest("Integer Power", powers);
+        bool roots = isqrt(bigint(0)) == 0 && isqrt(bigint(99)) == 9 && isqrt(bigint(100)) == 10
+                     && iroot(cube, 3) == big && iroot(cube - 1, 3) == big - 1 && iroot(-cube, 3) == -big
+                     && iroot(big, 1) == big && iroot(bigint(7), 100) == 1;
+        logTest("Small Roots", roots);
+        bool exact = true;
+        for (int i = 0; i < 10; ++i) {
+            bigint x = generateRandomBigint(2000 + std::rand() % 30000);
+            x = x < 0 ? -x : x;
+            bigint s = isqrt(x);
+            bigint r = iroot(x, 5);
+            exact = exact && s * s <= x && (s + 1) * (s + 1) > x && pow(r, 5) <= x && pow(r + 1, 5) > x;
+        }
+        logTest("Large Roots", exact);
+    } catch (const std::exception &e) {
+        logTest("Powers and Roots", false);
+        std::cout << "Error: " << e.what() << '\n';
+    }
+    try {
+        isqrt(bigint(-4));
+        logTest("Negative Square Root", false);
+    } catch (const std::domain_error &) {
+        logTest("Negative Square Root", true);
+    }
+}
+
+/**
+ * @brief Tests gcd, lcm, ext_gcd and modinv on both the Lehmer and half-GCD paths.
+ */
+void Gcd_tests() {
+    std::cout << "GCD Tests" << std::endl;
+    size_t threshold = bigint_tuning::hgcdThreshold;
+    try {
+        logTest("GCD Small", gcd(0, 0) == 0 && gcd(0, -5) == 5 && gcd(-12, 18) == 6 && gcd(17, 5) == 1
+                                 && lcm(4, -6) == 12 && lcm(0, 3) == 0);
+        bool cofactors = true;
+        for (size_t hgcdLimbs : {size_t(100000), size_t(8)}) {
+            bigint_tuning::hgcdThreshold = hgcdLimbs;
+            for (int i = 0; i < 40 && cofactors; ++i) {
+                bigint common = generateRandomBigint(1 + std::rand() % 200);
+                bigint a = generateRandomBigint(1 + std::rand() % 3000) * common;
+                bigint b = generateRandomBigint(1 + std::rand() % 3000) * common;
+                if (i % 2 == 1) {
+                    a = -a;
+                }
+                auto [g, x, y] = ext_gcd(a, b);
+                bigint period = b / g;
+                period = period < 0 ? -period : period;
+                cofactors = cofactors && g == gcd(a, b) && a % g == 0 && b % g == 0 && gcd(a / g, b / g) == 1
+                            && a * x + b * y == g && x >= 0 && x < period;
+            }
+        }
+        logTest("Extended GCD", cofactors);
+        bigint p("170141183460469231731687303715884105727");
+        bigint inverse = modinv(bigint("-123456789123456789"), p);
+        logTest("Modular Inverse", inverse * bigint("-123456789123456789") % p + p == 1 && modinv(5, 1) == 0);
+        bool threw = false;
+        try {
+            modinv(6, 9);
+        } catch (const std::domain_error &) {
+            threw = true;
+        }
+        logTest("Modular Inverse Error", threw);
+    } catch (const std::exception &e) {
+        logTest("GCD", false);
+        std::cout << "Error: " << e.what() << '\n';
+    }
+    bigint_tuning::hgcdThreshold = threshold;
+}
+
+/**
+ * @brief Tests fixed-width wide_int arithmetic and the _big literal against bigint.
+ */
+void WideInt_tests() {
+    std::cout << "Wide Integer Tests" << std::endl;
+    static_assert(sizeof(wide_int<256>) == 32);
+    static_assert(wide_int<128>(-7) / 2 == -3 && wide_int<128>(-7) % 2 == -1 && (wide_int<128>(-7) >> 1) == -4);
+    static_assert((wide_uint<128>(1) << 127) > wide_uint<128>(1) && (wide_int<128>(1) << 127) < 0);
+    static_assert(sizeof(18446744073709551616_big) == 16 && 0xFF'FF_big == 65535 && 0b1010_big == 012_big);
+    try {
+        bool arithmetic = true;
+        bigint modulus = pow(bigint(2), 256);
+        for (int i = 0; i < 200 && arithmetic; ++i) {
+            bigint a = generateRandomBigint(1 + std::rand() % 70);
+            bigint b = generateRandomBigint(1 + std::rand() % 70);
+            bigint product = a * b % modulus;
+            if (product < 0) {
+                product += modulus;
+            }
+            arithmetic = arithmetic && bigint(wide_int<256>(a) + wide_int<256>(b)) == a + b
+                         && bigint(wide_int<256>(a) - wide_int<256>(b)) == a - b
+                         && bigint(wide_uint<256>(a < 0 ? -a : a) * wide_uint<256>(b < 0 ? -b : b))
+                                == (a < 0 ? -a : a) * (b < 0 ? -b : b) % modulus
+                         && bigint(wide_int<256>(a) / wide_int<256>(b)) == a / b
+                         && bigint(wide_int<256>(a) % wide_int<256>(b)) == a % b
+                         && (wide_int<256>(a) < wide_int<256>(b)) == (a < b);
+        }
+        logTest("Wide Integer Arithmetic", arithmetic);
+        bigint big = 123456789012345678901234567890123456789_big;
+        logTest("Wide Integer Literal", big == bigint("123456789012345678901234567890123456789")
+                                            && bigint(-0x8000'0000'0000'0000_big) == bigint("-9223372036854775808"));
+        bigint minimum = -pow(bigint(2), 127);
+        bool ranges = bigint(wide_int<128>(minimum)) == minimum;
+        for (const bigint &outside : {minimum - 1, -minimum}) {
+            try {
+                wide_int<128> value(outside);
+                ranges = false;
+            } catch (const std::range_error &) {
+            }
+        }
+        try {
+            wide_uint<128> value(bigint(-1));
+            ranges = false;
+        } catch (const std::range_error &) {
+        }
+        logTest("Wide Integer Range", ranges);
+    } catch (const std::exception &e) {
+        logTest("Wide Integer", false);
+        std::cout << "Error: " << e.what() << '\n';
+    }
+}
+
+/**
+ * @brief Tests primality, next_prime and random_prime against a sieve and known pseudoprimes.
+ */
+void Prime_tests() {
+    std::cout << "Prime Tests" << std::endl;
+    size_t threads = bigint_tuning::threads;
+    size_t parallel = bigint_tuning::parallelThreshold;
+    try {
+        std::vector<bool> sieve(2000, true);
+        sieve[0] = sieve[1] = false;
+        for (size_t i = 2; i < sieve.size(); ++i) {
+            for (size_t j = i * i; sieve[i] && j < sieve.size(); j += i) {
+                sieve[j] = false;
+            }
+        }
+        bool small = !is_probable_prime(-7);
+        for (size_t i = 0; i < sieve.size(); ++i) {
+            small = small && is_probable_prime(static_cast<int64_t>(i)) == sieve[i];
+        }
+        logTest("Small Primes", small);
+        bigint mersenne127 = pow(bigint(2), 127) - 1;
+        bool large = is_probable_prime(mersenne127) && is_probable_prime(pow(bigint(2), 521) - 1, 5)
+                     && !is_probable_prime(pow(bigint(2), 128) + 1) && !is_probable_prime(mersenne127 * mersenne127)
+                     && !is_probable_prime(bigint("3825123056546413051"));
+        // Strong pseudoprimes to every prime base up to 37 and 41; only the Lucas test rejects them.
+        large = large && !is_probable_prime(bigint("318665857834031151167461"))
+                && !is_probable_prime(bigint("3317044064679887385961981"));
+        logTest("Large Primes", large);
+        bool next = next_prime(-5) == 2 && next_prime(2) == 3 && next_prime(13) == 17
+                    && next_prime(bigint("18446744073709551557")) == pow(bigint(2), 64) + 13
+                    && next_prime(mersenne127 - 1) == mersenne127;
+        logTest("Next Prime", next);
+        std::mt19937_64 rng(42);
+        bool sized = true;
+        for (size_t bits : {size_t(2), size_t(3), size_t(17), size_t(64), size_t(65), size_t(200)}) {
+            bigint p = random_prime(bits, rng);
+            sized = sized && is_probable_prime(p) && p >= pow(bigint(2), bits - 1) && p < pow(bigint(2), bits);
+        }
+        bool threw = false;
+        try {
+            random_prime(1, rng);
+        } catch (const std::domain_error &) {
+            threw = true;
+        }
+        logTest("Random Prime", sized && threw);
+        bigint start = pow(bigint(10), 150);
+        bigint serial = next_prime(start);
+        bigint_tuning::threads = 4;
+        bigint_tuning::parallelThreshold = 64;
+        logTest("Parallel Next Prime", next_prime(start) == serial && next_prime(serial) > serial);
+    } catch (const std::exception &e) {
+        logTest("Primes", false);
+        std::cout << "Error: " << e.what() << '\n';
+    }
+    bigint_tuning::threads = threads;
+    bigint_tuning::parallelThreshold = parallel;
+}
+
+/**
+ * @brief Tests factorial, binomial, primorial and product trees against naive products.
+ */
+void Combinatorics_tests() {
+    std::cout << "Combinatorics Tests" << std::endl;
+    size_t threads = bigint_tuning::threads;
+    size_t parallel = bigint_tuning::parallelThreshold;
+    try {
+        bigint naive = 1;
+        bool factorials = factorial(0) == 1 && factorial(1) == 1;
+        for (int64_t n = 2; n <= 3000; ++n) {
+            naive *= n;
+            if (n % 7 == 0 || n == 3000) {
+                factorials = factorials && factorial(static_cast<uint64_t>(n)) == naive;
+            }
+        }
+        logTest("Factorial", factorials);
+        bool binomials = binomial(0, 0) == 1 && binomial(5, 7) == 0 && binomial(52, 5) == 2598960
+                         && binomial(UINT64_MAX, 1) == bigint("18446744073709551615");
+        for (uint64_t n = 1; n < 400 && binomials; n += 13) {
+            for (uint64_t k = 0; k <= n; ++k) {
+                binomials = binomials && binomial(n, k) * factorial(k) * factorial(n - k) == factorial(n);
+            }
+        }
+        logTest("Binomial", binomials);
+        logTest("Primorial", primorial(1) == 1 && primorial(2) == 2 && primorial(30) == 6469693230
+                                 && primorial(100) == bigint("2305567963945518424753102147331756070"));
+        std::vector<bigint> values;
+        bigint sequential = 1;
+        for (int i = 0; i < 300; ++i) {
+            values.push_back(generateRandomBigint(1 + std::rand() % 400));
+            sequential *= values.back();
+        }
+        bigint_tuning::threads = 4;
+        bigint_tuning::parallelThreshold = 64;
+        bool products = product(values) == sequential && product(std::vector<bigint>{}) == 1;
+        products = products && factorial(20000) == factorial(19999) * 20000;
+        logTest("Product Tree", products);
+    } catch (const std::exception &e) {
+        logTest("Combinatorics", false);
+        std::cout << "Error: " << e.what() << '\n';
+    }
+    bigint_tuning::threads = threads;
+    bigint_tuning::parallelThreshold = parallel;
+}
 /**
  * @brief Main function to run all test cases.
- * @return Returns 0 on successful execution.
+ * @return Returns 0 when every test passed, 1 otherwise.
  */
 int main() {
     Unit_tests();
@@ -286,7 +1349,22 @@ int main() {
     Edge_cases();
     Error_handling();
     Consistency_tests();
+    Expression_tests();
+    Allocator_tests();
     Randomizing_tests();
+    Multiplication_tests();
+    Kernel_tests();
+    Batch_tests();
+    Modular_tests();
+    Stats_tests();
+    Serialization_tests();
+    Division_tests();
+    Power_tests();
+    Combinatorics_tests();
+    Gcd_tests();
+    WideInt_tests();
+    Prime_tests();
+    Conversion_tests();
     Stress_tests();
-    return 0;
+    return failed == 0 ? 0 : 1;
 }